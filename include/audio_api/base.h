@@ -9,5 +9,6 @@
 #include "types.h"
 
 RECOMP_IMPORT("magemods_audio_api", uintptr_t AudioApi_AddDmaCallback(AudioApiDmaCallback callback, u32 arg0, u32 arg1, u32 arg2));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_SetResidencyBudget(u32 budget));
 
 #endif
@@ -13,7 +13,34 @@ RECOMP_IMPORT("magemods_audio_api", bool AudioApi_AddSequenceFromFs(AudioApiSequ
 RECOMP_IMPORT("magemods_audio_api", bool AudioApi_AddSoundFontFromFs(AudioApiSoundFontInfo* info, char* dir, char* filename));
 RECOMP_IMPORT("magemods_audio_api", bool AudioApi_AddSampleBankFromFs(AudioApiSampleBankInfo* info, char* dir, char* filename));
 RECOMP_IMPORT("magemods_audio_api", bool AudioApi_AddAudioFileFromFs(AudioApiFileInfo* info, char* dir, char* filename));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_AddAudioFileFromFsEx(AudioApiFileInfo* info, AudioApiFileOptions* options, char* dir, char* filename));
 RECOMP_IMPORT("magemods_audio_api", uintptr_t AudioApi_GetResourceDevAddr(u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_RemoveResource(u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_PreloadResource(u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_PinResource(u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_UnpinResource(u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_EvictResource(u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_SetWarmStartBudget(u32 budget));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_SetResampleRate(u32 rate));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_SetOpenFileLimit(u32 limit));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_SetTracing(bool enabled));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_DumpTrace());
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_GetStreamingStats(AudioApiStreamingStats* stats, AudioApiStatsType type));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_ResetStreamingStats());
+RECOMP_IMPORT("magemods_audio_api", u32 AudioApi_GetResourceMemory(AudioApiResourceMemory* entries, u32 maxEntries, AudioApiMemorySort sort));
+RECOMP_IMPORT("magemods_audio_api", void AudioApi_GetMemoryTotal(AudioApiMemoryTotal* total));
+
+RECOMP_IMPORT("magemods_audio_api", s32 AudioApi_AddMasterEffect(AudioApiMasterEffect* effect));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_UpdateMasterEffect(s32 effectId, AudioApiMasterEffect* effect));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_RemoveMasterEffect(s32 effectId));
+
+RECOMP_IMPORT("magemods_audio_api", u32 AudioApi_CreateResourceGroup());
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_AddToResourceGroup(u32 groupId, u32 resourceId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_PrefetchResourceGroup(u32 groupId, bool notify));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_IsResourceGroupReady(u32 groupId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_PinResourceGroup(u32 groupId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_UnpinResourceGroup(u32 groupId));
+RECOMP_IMPORT("magemods_audio_api", bool AudioApi_ReleaseResourceGroup(u32 groupId));
 
 RECOMP_IMPORT("magemods_audio_api", s32 AudioApi_CreateStreamedSequence(AudioApiFileInfo* info, AudioApiSequenceIO seqIO));
 RECOMP_IMPORT("magemods_audio_api", s32 AudioApi_CreateStreamedBgm(AudioApiFileInfo* info, char* dir, char* filename, AudioApiSequenceIO seqIO));
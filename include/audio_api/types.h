@@ -16,6 +16,8 @@ typedef int8_t s8;
 typedef int16_t s16;
 typedef int32_t s32;
 typedef int64_t s64;
+
+typedef float f32;
 #endif
 
 typedef s32 (*AudioApiDmaCallback)(void* ramAddr, size_t size, size_t offset, u32 arg0, u32 arg1, u32 arg2);
@@ -50,6 +52,34 @@ typedef enum : u32 {
     AUDIOAPI_CHANNEL_TYPE_STEREO,
 } AudioApiChannelType;
 
+#define AUDIOAPI_MAX_MIX_TRACKS 16
+
+typedef enum : u32 {
+    AUDIOAPI_CHANNEL_MIX_NONE,              // Stream every track of the file
+    AUDIOAPI_CHANNEL_MIX_STEREO,            // Sum stereo pairs (stems) into 2 tracks
+    AUDIOAPI_CHANNEL_MIX_MONO,              // Sum every track into 1
+    AUDIOAPI_CHANNEL_MIX_SURROUND_STEREO,   // Downmix 5.0/5.1/7.1 to 2 tracks, other layouts as STEREO
+    AUDIOAPI_CHANNEL_MIX_SURROUND_MONO,     // Downmix 5.0/5.1/7.1 to 1 track, other layouts as MONO
+    AUDIOAPI_CHANNEL_MIX_REMAP,             // Track i is file track channelMap[i], mixTrackCount tracks
+} AudioApiChannelMix;
+
+typedef enum : u32 {
+    AUDIOAPI_SILENCE_NONE,
+    AUDIOAPI_SILENCE_MAP,                   // Serve silent tracks as zeros without decoding them
+    AUDIOAPI_SILENCE_TRIM_START,            // Also cut leading silence, up to loopStart if looping
+} AudioApiSilenceMode;
+
+typedef enum : u32 {
+    AUDIOAPI_MASTER_EQ_LOW_SHELF,
+    AUDIOAPI_MASTER_EQ_PEAK,
+    AUDIOAPI_MASTER_EQ_HIGH_SHELF,
+    AUDIOAPI_MASTER_EQ_LOW_PASS,
+    AUDIOAPI_MASTER_EQ_HIGH_PASS,
+    AUDIOAPI_MASTER_COMPRESSOR,
+    AUDIOAPI_MASTER_LIMITER,
+    AUDIOAPI_MASTER_REVERB,
+} AudioApiMasterEffectType;
+
 typedef enum : u32 {
     AUDIOAPI_SEQ_IO_NONE,          // No special IO channels
     AUDIOAPI_SEQ_IO_BREMEN,        // Channel 15, IO port 0: writes 0x00 every tatum (march sync)
@@ -72,12 +102,85 @@ typedef struct AudioApiFileInfo {
     AudioApiCacheStrategy cacheStrategy;
 } AudioApiFileInfo;
 
+// Decode options of AudioApi_AddAudioFileFromFsEx. Set size to sizeof(AudioApiFileOptions), fields
+// added in later versions keep their defaults for mods built against an older header.
+typedef struct AudioApiFileOptions {
+    u32 size;
+    u32 targetSampleRate;                   // Resample on decode, 0 = rate set by AudioApi_SetResampleRate
+    AudioApiChannelMix channelMix;          // Applied on decode, trackCount is then the mixed count
+    u32 mixTrackCount;
+    u32 channelMap[AUDIOAPI_MAX_MIX_TRACKS];
+    AudioApiSilenceMode silenceMode;
+} AudioApiFileOptions;
+
+typedef struct AudioApiMasterEffect {      // Fields not used by the type are ignored
+    AudioApiMasterEffectType type;
+    f32 frequency;                          // EQ corner or center frequency in Hz
+    f32 q;                                  // EQ, 0 = 0.707
+    f32 gainDb;                             // EQ shelf and peak gain, compressor makeup gain
+    f32 thresholdDb;                        // Compressor threshold, limiter ceiling
+    f32 ratio;                              // Compressor, 0 = 4:1
+    f32 attackMs;                           // Compressor attack (0 = 10), limiter lookahead (0 = 1.5)
+    f32 releaseMs;                          // Compressor (0 = 100), limiter (0 = 50)
+    f32 roomSize;                           // Reverb, 0 - 1
+    f32 damping;                            // Reverb, 0 - 1
+    f32 width;                              // Reverb stereo width, 0 - 1
+    f32 mix;                                // Reverb wet level, 0 - 1
+} AudioApiMasterEffect;
+
 typedef struct AudioApiResourceInfo {
     u32 resourceId;
     u32 filesize;
     AudioApiCacheStrategy cacheStrategy;
 } AudioApiResourceInfo;
 
+typedef enum : u32 {
+    AUDIOAPI_STATS_ALL,                     // Every DMA to a filesystem resource
+    AUDIOAPI_STATS_RESOURCE,                // Sequences and soundfonts
+    AUDIOAPI_STATS_SAMPLE_BANK,
+    AUDIOAPI_STATS_AUDIO_FILE,
+    AUDIOAPI_STATS_MAX,
+} AudioApiStatsType;
+
+typedef struct AudioApiStreamingStats {
+    u32 dmaCount;                           // DMAs since startup or the last reset
+    u32 hitCount;                           // Served from cache
+    u32 missCount;                          // Had to read or decode before returning
+    u32 errorCount;
+    u32 kibServed;
+    u32 latencyMeanNs;                      // Latencies of served DMAs
+    u32 latencyP50Ns;
+    u32 latencyP90Ns;
+    u32 latencyP99Ns;
+    u32 latencyMaxNs;
+    u32 preloadQueueDepth;                  // Resources waiting for the worker thread
+    u32 joinedDecodes;                      // Audio file chunk misses that waited for a decode already running
+} AudioApiStreamingStats;
+
+typedef enum : u32 {
+    AUDIOAPI_MEMORY_SORT_ID,
+    AUDIOAPI_MEMORY_SORT_SIZE,              // Largest cachedBytes + fileBytes first
+} AudioApiMemorySort;
+
+typedef struct AudioApiResourceMemory {
+    u32 resourceId;
+    u32 cachedBytes;                        // Decoded chunks or file pages
+    u32 entries;                            // Number of cached chunks or pages
+    u32 fileBytes;                          // Held by the file alone, zip entries are in zipEntryBytes
+    u32 mappedBytes;                        // Memory mapped view, paged in by the OS
+    u32 idleMs;                             // Since the last DMA, 0xFFFFFFFF if never used
+} AudioApiResourceMemory;
+
+typedef struct AudioApiMemoryTotal {
+    u32 resourceCount;
+    u32 cachedBytes;
+    u32 entries;
+    u32 fileBytes;
+    u32 mappedBytes;
+    u32 archiveBytes;                       // Zip archives, read into memory whole
+    u32 zipEntryBytes;                      // Inflated zip entries, open or kept for reuse
+} AudioApiMemoryTotal;
+
 typedef AudioApiResourceInfo AudioApiSequenceInfo;
 typedef AudioApiResourceInfo AudioApiSoundFontInfo;
 typedef AudioApiResourceInfo AudioApiSampleBankInfo;
@@ -15,6 +15,7 @@ typedef s32 (*AudioApiDmaCallback)(void* ramAddr, size_t size, size_t offset, u3
 
 uintptr_t AudioApi_AddDmaCallback(AudioApiDmaCallback callback, u32 arg0, u32 arg1, u32 arg2);
 uintptr_t AudioApi_AddDmaSubCallback(uintptr_t devAddr, u32 arg1, u32 arg2);
+void AudioApi_InvalidateDmaCallbacks(AudioApiDmaCallback callback, u32 arg0);
 s32 AudioApi_NativeDmaCallback(void* ramAddr, size_t size, size_t offset, u32 arg0, u32 arg1, u32 arg2);
 
 #endif
@@ -16,5 +16,7 @@ extern u8* sExtSoundFontLoadStatus;
 s32 AudioApi_GetTableEntryLoadStatus(s32 tableType, s32 id);
 void AudioApi_SetTableEntryLoadStatus(s32 tableType, s32 id, s32 status);
 void AudioApi_PushFakeCache(s32 tableType, s32 cache, s32 id);
+void AudioApi_DropFakeCache(s32 tableType, s32 id);
+bool AudioApi_IsPermanentlyCached(s32 tableType, s32 id);
 
 #endif
@@ -0,0 +1,12 @@
+#ifndef __AUDIO_API_RESIDENCY__
+#define __AUDIO_API_RESIDENCY__
+
+#include <global.h>
+
+#define RESIDENCY_DEFAULT_BUDGET 0x2000000 // 32 MiB of evictable sequence/soundfont copies
+
+void AudioApi_TrackResident(s32 tableType, s32 id, uintptr_t devAddr, void* ramAddr, void* allocAddr, size_t size);
+void AudioApi_UntrackResident(s32 tableType, s32 id);
+void AudioApi_ResidencyUpdate();
+
+#endif
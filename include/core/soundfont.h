@@ -10,10 +10,27 @@
 typedef enum SoundFontType : u8 {
     SOUNDFONT_VANILLA = 0,
     SOUNDFONT_CUSTOM,
+    SOUNDFONT_PACKED,
 } SoundFontType;
 
+// A packed soundfont is a single big-endian blob: a CustomSoundFont header padded to
+// SOUNDFONT_PACKED_HEADER_SIZE with type SOUNDFONT_PACKED, followed by a vanilla-layout font image.
+// The header's list pointers and every pointer inside the image are offsets relative to the start
+// of the image, and samples are addressed relative to their sample bank. Build them with
+// tools/pack_soundfont.py and load them like any other soundfont.
+#define SOUNDFONT_PACKED_HEADER_SIZE 0x20
+
+// Lists flagged here still point into the imported vanilla font image and are not separately
+// allocated. They are copied into their own allocation the first time they need to grow.
+typedef enum SoundFontSharedList : u8 {
+    SOUNDFONT_SHARED_INSTRUMENTS = (1 << 0),
+    SOUNDFONT_SHARED_DRUMS = (1 << 1),
+    SOUNDFONT_SHARED_SFX = (1 << 2),
+} SoundFontSharedList;
+
 typedef struct CustomSoundFont {
     SoundFontType type;
+    u8 sharedLists;
     u16 sampleBank1;
     u16 sampleBank2;
     u8 numInstruments;
@@ -27,4 +44,7 @@ typedef struct CustomSoundFont {
     SoundEffect* soundEffects;
 } CustomSoundFont;
 
+void AudioApi_FreeSoundFont(CustomSoundFont* soundFont);
+bool AudioApi_HasQueuedSoundFontChanges(s32 fontId);
+
 #endif
@@ -45,6 +45,15 @@ public:
     virtual void probe() = 0;
     virtual long decode(std::vector<int16_t>* buffer, size_t count, size_t offset) = 0;
 
+    // Builds whatever makes seeks fast, on the worker thread once the decoder is open. decode()
+    // only uses what is already built.
+    virtual void prepareSeek() {};
+
+    // Surround tracks come in Vorbis order (L, C, R...) instead of WAV order (L, R, C...)
+    virtual bool vorbisChannelOrder() const {
+        return false;
+    };
+
     std::shared_ptr<Metadata> metadata;
 
 protected:
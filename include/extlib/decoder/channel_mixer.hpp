@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <audio_api/types.h>
+
+namespace Decoder {
+
+// Maps the tracks of decoded frames to fewer (or reordered) tracks through a gain matrix
+class ChannelMixer {
+public:
+    // vorbisOrder: surround channels come in Vorbis order (L, C, R...) instead of WAV order (L, R, C...)
+    ChannelMixer(AudioApiChannelMix mix, uint32_t inTracks, bool vorbisOrder,
+                 const uint32_t* channelMap = nullptr, uint32_t mapCount = 0);
+
+    uint32_t outputTracks() const {
+        return outTracks;
+    };
+
+    void process(const int16_t* in, size_t frames, int16_t* out) const;
+
+private:
+    void stemsToStereo();
+    void surroundToStereo(bool vorbisOrder);
+    void stereoToMono();
+
+    float& gain(uint32_t out, uint32_t in) {
+        return matrix[out * inTracks + in];
+    };
+
+    uint32_t inTracks;
+    uint32_t outTracks = 0;
+    std::vector<float> matrix;
+};
+
+} // namespace Decoder
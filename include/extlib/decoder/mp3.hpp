@@ -13,6 +13,7 @@ public:
     void close() override;
     void probe() override;
     long decode(std::vector<int16_t>* buffer, size_t count, size_t offset) override;
+    void prepareSeek() override;
 
     static size_t onRead(void* datasrc, void* ptr, size_t bytes);
     static drmp3_bool32 onSeek(void* datasrc, int offset, drmp3_seek_origin whence);
@@ -21,6 +22,10 @@ public:
 
 private:
     drmp3* decoder = nullptr;
+
+    // Built by prepareSeek and kept across reopens, so seeks do not decode from the start
+    std::vector<drmp3_seek_point> seekPoints;
+    bool seekTableBuilt = false;
 };
 
 } // namespace Decoder
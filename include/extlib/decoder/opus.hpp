@@ -13,6 +13,9 @@ public:
     void close() override;
     void probe() override;
     long decode(std::vector<int16_t>* buffer, size_t count, size_t offset) override;
+    bool vorbisChannelOrder() const override {
+        return true;
+    };
 
     static int onRead(void* datasrc, unsigned char* ptr, int bytes);
     static int onSeek(void* datasrc, opus_int64 offset, int whence);
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Decoder {
+
+// Windowed sinc polyphase resampler between two fixed rates. Every output frame is computed from
+// its own input window, so any range of output can be produced on its own, which keeps chunks
+// independently decodable and cacheable.
+class Resampler {
+public:
+    Resampler(uint32_t inRate, uint32_t outRate);
+
+    // Output position of an input frame, rounded to nearest. Used for lengths and loop points.
+    size_t toOutput(size_t inFrame) const;
+
+    // Input frames [first, last) needed to produce count output frames from outStart.
+    // first can be negative and last past the end of the input, those frames count as silence.
+    std::pair<int64_t, int64_t> inputRange(size_t outStart, size_t count) const;
+
+    // in holds interleaved input frames starting at inStart, out receives count interleaved frames
+    void process(const int16_t* in, int64_t inStart, size_t inFrames, uint32_t channels,
+                 int16_t* out, size_t outStart, size_t count) const;
+
+    const uint32_t inRate;
+    const uint32_t outRate;
+
+private:
+    std::vector<float> coefficients;
+};
+
+} // namespace Decoder
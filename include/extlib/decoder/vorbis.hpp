@@ -13,6 +13,9 @@ public:
     void close() override;
     void probe() override;
     long decode(std::vector<int16_t>* buffer, size_t count, size_t offset) override;
+    bool vorbisChannelOrder() const override {
+        return true;
+    };
 
     static size_t onRead(void* ptr, size_t size, size_t nmemb, void* datasource);
     static int onSeek(void* datasrc, ogg_int64_t offset, int whence);
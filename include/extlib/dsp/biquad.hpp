@@ -0,0 +1,24 @@
+#pragma once
+#include <extlib/dsp/processor.hpp>
+
+namespace Dsp {
+
+// Second order EQ band, coefficients from the RBJ Audio EQ Cookbook
+class Biquad : public Processor {
+public:
+    Biquad(AudioApiMasterEffectType type) : type(type) {};
+
+    void configure(const AudioApiMasterEffect& params, uint32_t sampleRate) override;
+    void process(float* left, float* right, size_t frames) override;
+
+private:
+    AudioApiMasterEffectType type;
+
+    float b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+
+    // Transposed direct form II state, per channel
+    float z1[2] = {};
+    float z2[2] = {};
+};
+
+} // namespace Dsp
@@ -0,0 +1,42 @@
+#pragma once
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <extlib/dsp/processor.hpp>
+
+namespace Dsp {
+
+// Stereo linked compressor, or a lookahead brickwall limiter that never lets a sample past its
+// ceiling
+class Dynamics : public Processor {
+public:
+    Dynamics(bool limiter) : limiter(limiter) {};
+
+    void configure(const AudioApiMasterEffect& params, uint32_t sampleRate) override;
+    void process(float* left, float* right, size_t frames) override;
+
+private:
+    void compress(float* left, float* right, size_t frames);
+    void limit(float* left, float* right, size_t frames);
+
+    bool limiter;
+
+    float threshold = 1.0f;     // Linear, the ceiling for the limiter
+    float thresholdDb = 0.0f;
+    float slope = 0.0f;         // 1 - 1 / ratio
+    float makeup = 1.0f;
+    float attackCoef = 0.0f;
+    float releaseCoef = 0.0f;
+
+    float envelopeDb = 0.0f;    // Compressor gain reduction, limiter gain
+    float gain = 1.0f;
+
+    // Limiter lookahead: delayed input and a running minimum of the gains it needs
+    std::vector<float> delay[2];
+    size_t delayPos = 0;
+    size_t sampleIndex = 0;
+    std::deque<std::pair<size_t, float>> minGains;
+};
+
+} // namespace Dsp
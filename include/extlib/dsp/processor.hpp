@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <audio_api/types.h>
+
+namespace Dsp {
+
+// One stage of the master bus. Works in place on planar stereo floats, full scale is 1.0.
+class Processor {
+public:
+    virtual ~Processor() = default;
+
+    // Called whenever the parameters or the output sample rate change
+    virtual void configure(const AudioApiMasterEffect& params, uint32_t sampleRate) = 0;
+    virtual void process(float* left, float* right, size_t frames) = 0;
+};
+
+std::unique_ptr<Processor> factory(AudioApiMasterEffectType type);
+
+} // namespace Dsp
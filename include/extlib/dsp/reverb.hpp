@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <vector>
+
+#include <extlib/dsp/processor.hpp>
+
+namespace Dsp {
+
+// Algorithmic stereo reverb after Jezar's Freeverb: parallel damped comb filters into series
+// allpasses, the right channel detuned for width
+class Reverb : public Processor {
+public:
+    void configure(const AudioApiMasterEffect& params, uint32_t sampleRate) override;
+    void process(float* left, float* right, size_t frames) override;
+
+private:
+    static constexpr size_t NUM_COMBS = 8;
+    static constexpr size_t NUM_ALLPASSES = 4;
+
+    struct Comb {
+        std::vector<float> buffer;
+        size_t pos = 0;
+        float store = 0;
+    };
+
+    struct Allpass {
+        std::vector<float> buffer;
+        size_t pos = 0;
+    };
+
+    std::array<Comb, NUM_COMBS> combs[2];
+    std::array<Allpass, NUM_ALLPASSES> allpasses[2];
+    std::vector<float> scratch[2];
+
+    uint32_t sampleRate = 0;
+    float feedback = 0;
+    float damp = 0;
+    float wet1 = 0, wet2 = 0, dry = 1;
+};
+
+} // namespace Dsp
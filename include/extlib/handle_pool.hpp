@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+
+namespace Resource {
+class Audiofile;
+}
+
+constexpr size_t HANDLE_POOL_DEFAULT_LIMIT = 64;
+
+// Counts an audio file as holding open handles and closes the least recently used idle ones while
+// more than the limit are open
+void handlePoolTouch(Resource::Audiofile* owner);
+void handlePoolRemove(Resource::Audiofile* owner);
+
+void handlePoolSetLimit(size_t limit);
+size_t handlePoolOpenCount();
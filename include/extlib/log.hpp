@@ -0,0 +1,10 @@
+#pragma once
+#include <filesystem>
+
+#include <plog/Log.h>
+
+namespace fs = std::filesystem;
+
+// Routes plog through a lock-free ring drained by a background thread. With a logFile the
+// output also goes to a rotating file next to the console.
+void logInit(plog::Severity severity, fs::path logFile);
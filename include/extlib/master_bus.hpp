@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <audio_api/types.h>
+
+// Returns the id of the new effect, which runs after every effect added before it
+int32_t masterBusAdd(const AudioApiMasterEffect& effect);
+bool masterBusUpdate(int32_t id, const AudioApiMasterEffect& effect);
+bool masterBusRemove(int32_t id);
+
+// Runs the chain in place over frames of interleaved stereo at ptr
+void masterBusProcess(uint8_t* rdram, int32_t ptr, size_t frames, uint32_t sampleRate);
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+void profileLoad(fs::path path);
+void profileSave();
+void profileWarmStart();
+void profileSetWarmBudget(size_t bytes);
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Bulk copies into rdram. The emulated RDRAM keeps every 32-bit word in host byte order, so byte
+// addresses are swizzled (^3 for bytes, ^2 for halfwords). These helpers handle the unaligned head
+// and tail with scalar writes and move whole words in between, instead of recomputing the swizzle
+// for every byte like MEM_B does.
+
+// Copy size bytes of big-endian data from src to ptr
+void copy_to_rdram(uint8_t* rdram, int32_t ptr, const uint8_t* src, size_t size);
+
+// Set size bytes at ptr to value
+void fill_rdram(uint8_t* rdram, int32_t ptr, uint8_t value, size_t size);
+
+// Copy count halfwords at ptr to dst
+void copy_halfwords_from_rdram(uint8_t* rdram, int32_t ptr, int16_t* dst, size_t count);
+
+// Copy count halfwords to ptr, taking every stride-th value from src (stride > 1 de-interleaves tracks)
+void copy_halfwords_to_rdram(uint8_t* rdram, int32_t ptr, const int16_t* src, size_t count, size_t stride = 1);
@@ -1,13 +1,24 @@
 #pragma once
 
 #include <any>
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <audio_api/types.h>
 
+#include <extlib/utils.hpp>
+
 namespace Resource {
 
+// Granularity of session profiling, about this many bytes of cached data per range
+constexpr size_t PROFILE_RANGE_SIZE = 64 * 1024;
+
 enum class CacheStrategy {
     Default             = AUDIOAPI_CACHE_DEFAULT,
     None                = AUDIOAPI_CACHE_NONE,
@@ -35,15 +46,107 @@ struct PreloadTask {
     std::any data;
 };
 
+// Task data asking a resource to load everything, regardless of its cache strategy
+struct FullPreload {};
+
+// Memory held on behalf of a resource
+struct MemoryInfo {
+    size_t cachedBytes = 0;     // Decoded chunks or file pages
+    size_t entries = 0;         // Number of chunks or pages
+    size_t fileBytes = 0;       // Held by the file itself, not shared with other files
+    size_t mappedBytes = 0;     // Memory mapped view, paged in and out by the OS
+};
+
 class Abstract {
 public:
     virtual void dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t count, uint32_t arg1, uint32_t arg2) = 0;
     virtual std::vector<PreloadTask> getPreloadTasks() = 0;
     virtual void runPreloadTask(const PreloadTask& task) = 0;
     virtual void gc() = 0;
+    virtual MemoryInfo getMemoryInfo() = 0;
+
+    // Time of the last DMA, EPOCH if never used
+    std::chrono::steady_clock::time_point lastUse() const {
+        return lastUseTime.load();
+    };
+
+    // Residency control requested by mods. Preloads run and evictions happen on the worker thread.
+    void requestPreload() {
+        preloadPending = true;
+        preloadRequested = true;
+    };
+
+    // Called by the worker thread once a FullPreload task has run
+    void preloadFinished() {
+        if (!preloadRequested) {
+            preloadPending = false;
+        }
+    };
+
+    bool isPreloaded() const {
+        return !preloadPending;
+    };
+
+    void requestEvict() {
+        evictRequested = true;
+    };
+
+    void pin() {
+        pinned = true;
+    };
+
+    void unpin() {
+        pinned = false;
+    };
+
+    // Session profiling. DMAs count uses per range, warm start loads the hottest ranges of earlier sessions.
+    virtual void preloadRange(size_t range) = 0;
+
+    void markWarm() {
+        warm = true;
+    };
+
+    std::map<size_t, uint32_t> takeUsedRanges() {
+        std::lock_guard<std::mutex> lock(usedRangesMutex);
+        return std::exchange(usedRanges, {});
+    };
+
+    // Stable across sessions, set on registration
+    std::string profileKey;
 
 protected:
     bool initialPreload = true;
+    std::atomic<bool> preloadRequested = false;
+    std::atomic<bool> preloadPending = false;
+    std::atomic<bool> evictRequested = false;
+
+    // Pinned resources keep their caches until unpinned or explicitly evicted
+    std::atomic<bool> pinned = false;
+
+    // Warm started resources keep their caches until first used
+    std::atomic<bool> warm = false;
+
+    bool keepCache() const {
+        return pinned || warm;
+    };
+
+    // Consecutive DMAs to the same range count once
+    void markUsed(size_t range) {
+        warm = false;
+        lastUseTime.store(std::chrono::steady_clock::now());
+        if (lastUsedRange.exchange(range) == range) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(usedRangesMutex);
+        usedRanges[range]++;
+    };
+
+private:
+    std::map<size_t, uint32_t> usedRanges;
+    std::mutex usedRangesMutex;
+    std::atomic<size_t> lastUsedRange = SIZE_MAX;
+    std::atomic<std::chrono::steady_clock::time_point> lastUseTime{EPOCH};
 };
 
 using ResourcePtr = std::shared_ptr<Abstract>;
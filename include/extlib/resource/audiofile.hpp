@@ -2,12 +2,16 @@
 
 #include <atomic>
 #include <chrono>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <vector>
 
 #include <extlib/decoder/abstract.hpp>
+#include <extlib/decoder/channel_mixer.hpp>
+#include <extlib/decoder/resampler.hpp>
 #include <extlib/resource/abstract.hpp>
 #include <extlib/utils.hpp>
 #include <extlib/vfs/file.hpp>
@@ -25,25 +29,119 @@ public:
     void close();
     void probe();
 
+    // For the handle pool: closes the file and decoder unless a decode is running. Cached chunks
+    // and cursors are kept, the next decode reopens them.
+    bool closeIdle();
+
+    // Mix and resample on decode, after probing, in this order. metadata then describes the
+    // decoded stream.
+    void setChannelMix(AudioApiChannelMix mix, const uint32_t* channelMap = nullptr, uint32_t mapCount = 0);
+    void setTargetSampleRate(uint32_t rate);
+
+    // Last, once profileKey is set. The silence map is loaded from earlier sessions or filled in
+    // as chunks are decoded. A trim found by the worker applies from the next registration on.
+    void setSilenceMode(AudioApiSilenceMode mode);
+
     std::shared_ptr<std::vector<int16_t>> getChunk(size_t offset);
+    size_t getCachedChunks();
 
     void dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t count, uint32_t trackNo, uint32_t arg2) override;
     std::vector<PreloadTask> getPreloadTasks() override;
     void runPreloadTask(const PreloadTask& task) override;
     void gc() override;
+    void preloadRange(size_t range) override;
+    MemoryInfo getMemoryInfo() override;
 
     std::shared_ptr<Decoder::Metadata> metadata;
 
+    // Chunks decoded on the main thread because the worker had not preloaded them
+    std::atomic<size_t> syncDecodes = 0;
+
+    // Chunk misses that waited for a decode another thread had already started
+    std::atomic<size_t> joinedDecodes = 0;
+
 private:
+    // Playheads of everything streaming this file, e.g. a BGM and a crossfading copy of it. DMAs
+    // move the nearest cursor with the same key (the DMA's arg2) or start a new one, cursors
+    // expire once unused for a while. Preloading and eviction consider all of them.
+    struct Cursor {
+        uint32_t key;
+        size_t pos;
+        std::chrono::steady_clock::time_point lastUse;
+
+        // Frames consumed per second, measured over windows starting at ratePos
+        double rate;
+        size_t ratePos;
+        std::chrono::steady_clock::time_point rateStart;
+    };
+
+    void openHandles();
+    void closeHandles();
+
+    std::shared_ptr<std::vector<int16_t>> decodeChunk(size_t offset);
+    size_t decodeMixed(std::vector<int16_t>* buffer, size_t count, size_t offset);
+    size_t decodeResampled(std::vector<int16_t>* buffer, size_t count, size_t offset);
+
+    size_t findLeadingSilence();
+    void trimStart(size_t frames);
+    void recordSilence(size_t offset, const std::vector<int16_t>& data);
+    bool isSilent(size_t offset, uint32_t trackNo);
+    bool isChunkSilent(size_t offset);
+    void scanSilence();
+    void scanLeadingSilence();
+
+    void updateCursor(uint32_t key, size_t offset);
+    void expireCursors();
+    std::vector<Cursor> liveCursors();
+    size_t lookaheadChunks(double rate);
+
     std::shared_ptr<Vfs::File> file;
     std::unique_ptr<Decoder::Abstract> decoder;
 
+    // Decodes hold handleMutex shared, closing takes it exclusively
+    std::atomic<bool> handlesOpen = false;
+    std::atomic<bool> seekPrepared = false;
+    std::shared_mutex handleMutex;
+    std::mutex openMutex;
+    std::unique_ptr<Decoder::ChannelMixer> mixer;
+
+    // Chunks overlap in the source by the filter length, the tail of the last decode is kept so
+    // sequential chunks do not seek the decoder backwards
+    std::unique_ptr<Decoder::Resampler> resampler;
+    std::vector<int16_t> sourceTail;
+    size_t sourceTailStart = 0;
+    std::mutex resampleMutex;
+
+    // Identifies the decode settings, silence maps are only reused for the same ones
+    std::string decodeKey;
+
+    // Leading source frames skipped by every decode
+    size_t trimFrames = 0;
+    std::atomic<bool> trimScanPending = false;
+
+    // Per chunk the tracks that decoded to digital silence, SILENCE_KNOWN is set once the chunk
+    // was decoded. Silent tracks are DMAd as zeros and fully silent chunks are neither decoded
+    // again nor cached. Empty if silence detection is off.
+    std::vector<uint32_t> silentTracks;
+    std::atomic<size_t> silenceUnknown = 0;
+    std::atomic<bool> silenceStored = false;
+    std::shared_mutex silenceMutex;
+    std::shared_ptr<std::vector<int16_t>> silentChunk;
+
     size_t numChunks = 0;
-    std::atomic<size_t> pos = 0;
+
+    std::vector<Cursor> cursors;
+    std::mutex cursorMutex;
+
+    // Lookahead chunks this file's cursors asked for, counted against the cap shared by all files
+    std::atomic<size_t> lookaheadWanted = 0;
     std::atomic<std::chrono::steady_clock::time_point> atime{EPOCH};
 
     CacheStrategy cacheStrategy;
     std::map<size_t, std::shared_ptr<std::vector<int16_t>>> cache;
+
+    // Chunks being decoded, a miss on one of them waits for that decode instead of starting another
+    std::map<size_t, std::shared_future<std::shared_ptr<std::vector<int16_t>>>> pending;
     std::shared_mutex cacheMutex;
 };
 
@@ -3,7 +3,10 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <extlib/resource/abstract.hpp>
@@ -12,6 +15,11 @@
 
 namespace Resource {
 
+struct CachePage {
+    std::vector<uint8_t> data;
+    std::atomic<uint64_t> lastUse = 0;
+};
+
 class Generic : public Abstract {
 public:
     Generic() = delete;
@@ -32,14 +40,39 @@ public:
     std::vector<PreloadTask> getPreloadTasks() override;
     void runPreloadTask(const PreloadTask& task) override;
     void gc() override;
+    void preloadRange(size_t range) override;
+    MemoryInfo getMemoryInfo() override;
 
 protected:
+    bool map();
+    void unmap();
+    void dmaPaged(uint8_t* rdram, int32_t ptr, size_t offset, size_t size);
+    void fillPages(size_t offset, size_t size);
+    std::vector<uint8_t> readPage(size_t index);
+    bool insertPage(size_t index, std::vector<uint8_t>&& data);
+    void clearPages();
+
     std::shared_ptr<Vfs::File> file;
     std::atomic<std::chrono::steady_clock::time_point> atime{EPOCH};
 
+    // Held across open, seek and read, the audio, worker and warm start threads share the file position
+    std::mutex readMutex;
+
     CacheStrategy cacheStrategy;
-    std::vector<uint8_t> cache;
+
+    // Native files are served straight from a read-only mapping, the page cache is the fallback
+    std::atomic<const uint8_t*> mapping = nullptr;
+    bool mapFailed = false;
+    Vfs::MapAdvice mapAdvice = Vfs::MapAdvice::Sequential;
+
+    // Page index -> page, filled on demand, by read-ahead or by preload
+    std::unordered_map<size_t, CachePage> pages;
+    size_t cachedBytes = 0;
+    std::atomic<uint64_t> useCounter = 0;
     std::shared_mutex cacheMutex;
+
+    std::set<size_t> pendingPages;
+    std::mutex pendingPagesMutex;
 };
 
 } // namespace Resource
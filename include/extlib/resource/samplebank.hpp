@@ -1,6 +1,10 @@
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
 
 #include <extlib/resource/generic.hpp>
 #include <extlib/vfs/file.hpp>
@@ -14,7 +18,19 @@ public:
 
     ~SampleBank();
 
-    void dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t size, uint32_t devAddr, uint32_t arg2) override;
+    void dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t size, uint32_t devAddr, uint32_t sampleSize) override;
+    std::vector<PreloadTask> getPreloadTasks() override;
+    void runPreloadTask(const PreloadTask& task) override;
+
+private:
+    size_t learnSample(size_t devAddr, size_t sampleSize, size_t end);
+
+    // Sample start -> sample size, learned from the relocated soundfonts or the DMA pattern
+    std::map<size_t, size_t> sampleSizes;
+    std::mutex sampleSizesMutex;
+
+    std::set<size_t> pendingSamples;
+    std::mutex pendingSamplesMutex;
 };
 
 } // namespace Resource
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Where an audio file decodes to digital silence, per chunk of decoded frames
+struct SilenceMap {
+    size_t trimFrames = 0;                  // Leading silence cut from the file, in source frames
+    std::vector<uint32_t> silentTracks;     // Per chunk, bit n is set if track n is silent
+};
+
+void silenceLoad(fs::path path);
+std::optional<SilenceMap> silenceFind(const std::string& key);
+void silenceStore(const std::string& key, SilenceMap map);
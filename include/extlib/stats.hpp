@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <audio_api/types.h>
+
+// Called from a resource's DMA path when the request could not be served from cache
+void statsMarkMiss();
+
+// Called when a chunk request waited for a decode another thread had already started
+void statsMarkJoinedDecode();
+
+// Wraps one DMA: begin clears the miss marker of the calling thread, end records the latency
+// into the histogram of the resource type and the global one
+void statsBeginDma();
+void statsEndDma(AudioApiStatsType type, uint64_t latencyNs, size_t bytes, bool ok);
+
+void statsGet(AudioApiStatsType type, AudioApiStreamingStats* stats);
+void statsReset();
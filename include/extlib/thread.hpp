@@ -8,3 +8,4 @@ extern std::thread::id gWorkerThreadId;
 void workerThreadNotify();
 void workerThreadLoop();
 void queuePreload(size_t resourceId);
+size_t preloadQueueDepth();
@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+extern std::atomic<bool> gTraceEnabled;
+
+void traceSetOutputDir(fs::path dir);
+void traceSetThreadName(const char* name);
+void traceEnable(bool enabled);
+fs::path traceDump();
+
+uint64_t traceNow();
+void traceRecord(const char* name, const char* category, uint64_t start, const char* argName, uint64_t arg);
+
+// Records a complete event from construction to destruction on the calling thread's ring buffer.
+// Names must be string literals. With tracing disabled this costs a single branch.
+class TraceScope {
+public:
+    TraceScope(const char* name, const char* category, const char* argName = nullptr, uint64_t arg = 0)
+        : name(name), category(category), argName(argName), arg(arg),
+          start(gTraceEnabled.load(std::memory_order_relaxed) ? traceNow() : 0) {}
+
+    ~TraceScope() {
+        if (start != 0) {
+            traceRecord(name, category, start, argName, arg);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    const char* argName;
+    uint64_t arg;
+    uint64_t start;
+};
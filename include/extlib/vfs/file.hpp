@@ -8,6 +8,14 @@ namespace fs = std::filesystem;
 
 namespace Vfs {
 
+// Expected access pattern of a mapped range, passed on to the OS page cache
+enum class MapAdvice {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed,
+};
+
 class File {
 public:
     File() = delete;
@@ -18,6 +26,27 @@ public:
     virtual int64_t seek(int64_t offset, int whence) = 0;
     virtual int64_t tell() = 0;
 
+    // Read-only mapping of the whole file, nullptr if the file can't be mapped
+    virtual const uint8_t* map() {
+        return nullptr;
+    };
+
+    virtual void unmap() {};
+
+    // Starts loading the file in the background, so the next open does not have to wait
+    virtual void prefetch() {};
+    virtual void advise(size_t offset, size_t size, MapAdvice advice) {};
+
+    // Last modification in file clock ticks, only compared for equality. 0 if unknown.
+    virtual int64_t modifiedTime() {
+        return 0;
+    };
+
+    // Memory the file holds on its own, besides mappings and shared zip entries
+    virtual size_t residentBytes() {
+        return 0;
+    };
+
     size_t size() const {
         return filesize;
     };
@@ -20,9 +20,15 @@ public:
     size_t read(void* buffer, size_t bytes) override;
     int64_t seek(int64_t offset, int whence) override;
     int64_t tell() override;
+    int64_t modifiedTime() override;
+
+    const uint8_t* map() override;
+    void unmap() override;
+    void advise(size_t offset, size_t size, MapAdvice advice) override;
 
 private:
     std::ifstream stream;
+    const uint8_t* mapping = nullptr;
 };
 
 } // namespace Vfs
@@ -28,8 +28,17 @@ public:
     void init();
     FileInfo locateFile(std::string path);
     void extractFileToBuffer(std::string path, std::vector<uint8_t>& buffer);
+    void extractEntryToBuffer(const FileInfo& info, std::vector<uint8_t>& buffer);
     size_t extractBytesToBuffer(void* buffer, size_t bytes, size_t offset);
 
+    // Of the archive file when it was read
+    int64_t modifiedTime() const {
+        return mtime;
+    };
+
+    // Archives are read into memory whole and shared by all of their files
+    static size_t totalResidentBytes();
+
 private:
     struct Private{ explicit Private() = default; };
 
@@ -37,6 +46,7 @@ private:
 
     void* mz_archive;
     size_t filesize;
+    int64_t mtime = 0;
     fs::path path;
     std::vector<uint8_t> data;
     std::mutex mutex;
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <extlib/vfs/zip_archive.hpp>
+
+namespace Vfs {
+
+// Inflated zip entries, shared by every ZipFile open on them and kept after the last close until
+// the budget needs the room, least recently used first
+class ZipEntryCache {
+public:
+    using Data = std::shared_ptr<const std::vector<uint8_t>>;
+
+    // Blocks until the entry is inflated, joining an inflate already running. Every acquire must
+    // be paired with a release.
+    static Data acquire(std::shared_ptr<ZipArchive> archive, const ZipArchive::FileInfo& info);
+    static void release(const ZipArchive* archive, size_t index);
+
+    // Inflates the entry on a background thread if it is not cached yet
+    static void prefetch(std::shared_ptr<ZipArchive> archive, const ZipArchive::FileInfo& info);
+
+    static size_t totalBytes();
+};
+
+} // namespace Vfs
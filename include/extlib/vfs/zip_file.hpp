@@ -7,6 +7,7 @@
 
 #include <extlib/vfs/file.hpp>
 #include <extlib/vfs/zip_archive.hpp>
+#include <extlib/vfs/zip_entry_cache.hpp>
 
 namespace fs = std::filesystem;
 
@@ -23,12 +24,16 @@ public:
     size_t read(void* buffer, size_t bytes) override;
     int64_t seek(int64_t offset, int whence) override;
     int64_t tell() override;
+    void prefetch() override;
+    int64_t modifiedTime() override;
 
 private:
     ZipArchive::FileInfo info;
 
     size_t curPos = 0;
-    std::vector<uint8_t> buffer;
+
+    // Compressed entries are read from the shared inflated copy while open
+    ZipEntryCache::Data entry;
     std::shared_ptr<ZipArchive> archive;
 };
 
@@ -5,6 +5,7 @@
 #include <utils/queue.h>
 #include <core/heap.h>
 #include <core/load.h>
+#include <core/residency.h>
 
 /*
  * init.c — Patches AudioLoad_Init to insert the Audio API initialization lifecycle.
@@ -22,9 +23,12 @@
  *   READY / AudioApi_Ready   | Client mods (public event)  | Mods interact post-load
  *
  * The native (C++) side is managed via RECOMP_IMPORT functions:
- *   AudioApiNative_Init  — called during InitInternal, sets up extlib thread + VFS
+ *   AudioApiNative_Init  — called during InitInternal, sets up extlib thread, VFS and logging
  *   AudioApiNative_Ready — called during ReadyInternal, signals extlib loading complete
  *   AudioApiNative_Tick  — called every audio thread update (hooked on AudioThread_UpdateImpl)
+ *
+ * The same hook drives AudioApi_ResidencyUpdate, which evicts idle sequence/soundfont copies, and
+ * fires AudioApi_UpdateInternal for subsystems that poll the native side (e.g. resource groups).
  */
 
 extern void AudioLoad_InitTable(AudioTable* table, uintptr_t romAddr, u16 unkMediumParam);
@@ -34,20 +38,21 @@ AudioApiInitPhase gAudioApiInitPhase = AUDIOAPI_INIT_NOT_READY;
 /* Internal events — API subsystems register RECOMP_CALLBACKs on these (e.g. effects.c, load.c) */
 RECOMP_DECLARE_EVENT(AudioApi_InitInternal());
 RECOMP_DECLARE_EVENT(AudioApi_ReadyInternal());
+RECOMP_DECLARE_EVENT(AudioApi_UpdateInternal());
 
 /* Public events — client mods register callbacks to queue/finalize audio data */
 RECOMP_DECLARE_EVENT(AudioApi_Init());
 RECOMP_DECLARE_EVENT(AudioApi_Ready());
 
 /* Native (C++) extlib interface — manages decoder thread, VFS, and resource loading */
-RECOMP_IMPORT(".", bool AudioApiNative_Init(u32 log_level, unsigned char* mod_dir));
+RECOMP_IMPORT(".", bool AudioApiNative_Init(u32 log_level, unsigned char* mod_dir, bool log_to_file));
 RECOMP_IMPORT(".", bool AudioApiNative_Ready());
 RECOMP_IMPORT(".", bool AudioApiNative_Tick());
 
 /* Boot the native extlib (C++ decoder/VFS layer) during internal init phase */
 RECOMP_CALLBACK(".", AudioApi_InitInternal) void AudioApi_ExtLibInit() {
     unsigned char* mod_folder = recomp_get_mod_folder_path();
-    AudioApiNative_Init(6, mod_folder); // log_level 6 = verbose
+    AudioApiNative_Init(6, mod_folder, recomp_get_config_u32("log_to_file") != 0); // log_level 6 = verbose
     recomp_free(mod_folder);
 }
 
@@ -59,6 +64,8 @@ RECOMP_CALLBACK(".", AudioApi_ReadyInternal) void AudioApi_ExtLibReady() {
 /* Per-frame tick for native extlib — drives async decode, resource streaming, etc. */
 RECOMP_HOOK_RETURN("AudioThread_UpdateImpl") void on_AudioThread_UpdateImpl() {
     AudioApiNative_Tick();
+    AudioApi_ResidencyUpdate();
+    AudioApi_UpdateInternal();
 }
 
 /*
@@ -1,7 +1,9 @@
 #include <core/load.h>
 #include <recomp/modding.h>
+#include <recomp/recompdata.h>
 #include <recomp/recomputils.h>
 #include <utils/dynamicdataarray.h>
+#include <utils/misc.h>
 #include <core/load_status.h>
 #include <core/heap.h>
 
@@ -16,6 +18,7 @@
 #define ASYNC_STATUS(v) ((u8)(v >> 0))
 
 #define DMA_CALLBACK_DEFAULT_CAPACITY 32
+#define DMA_CALLBACK_MAX_COUNT (K0BASE - DMA_CALLBACK_START_DEV_ADDR)
 
 typedef struct AudioApiDmaCallbackEntry {
     AudioApiDmaCallback callback;
@@ -27,6 +30,7 @@ typedef struct AudioApiDmaCallbackEntry {
 extern DmaHandler sDmaHandler;
 
 DynamicDataArray dmaCallbacks;
+U32ValueHashmapHandle dmaCallbackIds; // FNV32 hash of an entry -> its id, equal entries share one
 OSIoMesg currAudioFrameDmaIoMesgBuf[MAX_SAMPLE_DMA_PER_FRAME];
 OSMesg currAudioFrameDmaMesgBuf[MAX_SAMPLE_DMA_PER_FRAME];
 
@@ -47,6 +51,7 @@ RECOMP_IMPORT(".", bool AudioApiNative_Dma(s16* buf, u32 size, u32 offset, u32*
 
 RECOMP_CALLBACK(".", AudioApi_InitInternal) void AudioApi_LoadInit() {
     DynDataArr_init(&dmaCallbacks, sizeof(AudioApiDmaCallbackEntry), DMA_CALLBACK_DEFAULT_CAPACITY);
+    dmaCallbackIds = recomputil_create_u32_value_hashmap();
 }
 
 // ======== LOAD FUNCTIONS ========
@@ -191,18 +196,37 @@ RECOMP_PATCH u8* AudioLoad_SyncLoadSeq(s32 seqId) {
 
 // ======== DMA FUNCTIONS ========
 
+/* Fonts relocate their samples again every time they are reloaded, so an entry equal to an existing
+ * one returns that entry's device address instead of growing the table. */
 RECOMP_EXPORT uintptr_t AudioApi_AddDmaCallback(AudioApiDmaCallback callback, u32 arg0, u32 arg1, u32 arg2) {
-    u16 id = dmaCallbacks.count;
     AudioApiDmaCallbackEntry entry = { callback, arg0, arg1, arg2 };
+    AudioApiDmaCallbackEntry* existing;
+    Fnv32_t hval = fnv_32a_buf(&entry, sizeof(entry), FNV1_32A_INIT);
+    unsigned long id;
+
+    if (recomputil_u32_value_hashmap_get(dmaCallbackIds, hval, &id)) {
+        existing = DynDataArr_get(&dmaCallbacks, id);
+        if (existing->callback == callback && existing->arg0 == arg0 &&
+            existing->arg1 == arg1 && existing->arg2 == arg2) {
+            return DMA_CALLBACK_START_DEV_ADDR + id;
+        }
+        recomputil_u32_value_hashmap_erase(dmaCallbackIds, hval);
+    }
+
+    if (dmaCallbacks.count >= DMA_CALLBACK_MAX_COUNT) {
+        return (uintptr_t)NULL;
+    }
 
+    id = dmaCallbacks.count;
     DynDataArr_push(&dmaCallbacks, &entry);
+    recomputil_u32_value_hashmap_insert(dmaCallbackIds, hval, id);
 
     return DMA_CALLBACK_START_DEV_ADDR + id;
 }
 
 RECOMP_EXPORT uintptr_t AudioApi_AddDmaSubCallback(uintptr_t devAddr, u32 arg1, u32 arg2) {
-    u16 id = devAddr - DMA_CALLBACK_START_DEV_ADDR;
-    if (id >= (u16)dmaCallbacks.count) {
+    u32 id = devAddr - DMA_CALLBACK_START_DEV_ADDR;
+    if (id >= dmaCallbacks.count) {
         return (uintptr_t)NULL;
     }
 
@@ -210,6 +234,19 @@ RECOMP_EXPORT uintptr_t AudioApi_AddDmaSubCallback(uintptr_t devAddr, u32 arg1,
     return AudioApi_AddDmaCallback(entry->callback, entry->arg0, arg1, arg2);
 }
 
+/* Make every callback entry bound to callback and arg0 fail from now on. Entries are never reused,
+ * since device addresses handed out earlier may still be stored in tables or samples. */
+void AudioApi_InvalidateDmaCallbacks(AudioApiDmaCallback callback, u32 arg0) {
+    AudioApiDmaCallbackEntry* entry;
+
+    for (size_t i = 0; i < dmaCallbacks.count; i++) {
+        entry = DynDataArr_get(&dmaCallbacks, i);
+        if (entry->callback == callback && entry->arg0 == arg0) {
+            entry->callback = NULL;
+        }
+    }
+}
+
 RECOMP_EXPORT s32 AudioApi_NativeDmaCallback(void* ramAddr, size_t size, size_t offset, u32 arg0, u32 arg1, u32 arg2) {
     u32 args[] = {arg0, arg1, arg2};
 
@@ -221,16 +258,19 @@ RECOMP_EXPORT s32 AudioApi_NativeDmaCallback(void* ramAddr, size_t size, size_t
 }
 
 s32 AudioApi_Dma_Callback(uintptr_t devAddr, void* ramAddr, size_t size, size_t offset) {
-    u16 id = devAddr - DMA_CALLBACK_START_DEV_ADDR;
+    u32 id = devAddr - DMA_CALLBACK_START_DEV_ADDR;
 
     if (gAudioCtx.resetTimer > 16) {
         return -1;
     }
-    if (id >= (u16)dmaCallbacks.count) {
+    if (id >= dmaCallbacks.count) {
         return -1;
     }
 
     AudioApiDmaCallbackEntry* entry = DynDataArr_get(&dmaCallbacks, id);
+    if (entry->callback == NULL) {
+        return -1;
+    }
     return entry->callback(ramAddr, size, offset, entry->arg0, entry->arg1, entry->arg2);
 }
 
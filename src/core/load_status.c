@@ -26,6 +26,9 @@
  * Extended load-status arrays (sExtSeqLoadStatus / sExtSoundFontLoadStatus) start as aliases
  * to the vanilla arrays and are swapped to larger allocations by load.c when tables grow.
  *
+ * Entries evicted by residency.c are dropped from all three caches (AudioApi_DropFakeCache), so
+ * the next load runs the relocation path again.
+ *
  * Special IDs: 0xFF and 0xFE are sentinel values used by the game for "no sequence" / "previous
  * sequence" — these are short-circuited to LOAD_STATUS_PERMANENT to avoid table lookups.
  */
@@ -181,6 +184,28 @@ void AudioApi_PushFakeCache(s32 tableType, s32 cachePolicy, s32 id) {
     }
 }
 
+/* Forget a resource in every cache tier so the next load treats it as a first load again. */
+void AudioApi_DropFakeCache(s32 tableType, s32 id) {
+    u32 realId = AudioLoad_GetRealTableIndex(tableType, id);
+    u32 key = tableType << 24 | realId;
+    s32 i, j;
+
+    recomputil_u32_hashset_erase(loadedCache, key);
+    recomputil_u32_hashset_erase(permanentCache, key);
+
+    for (i = 0, j = 0; i < persistentCache.numEntries; i++) {
+        if (persistentCache.entries[i].tableType != tableType || persistentCache.entries[i].id != realId) {
+            persistentCache.entries[j++] = persistentCache.entries[i];
+        }
+    }
+    persistentCache.numEntries = j;
+}
+
+bool AudioApi_IsPermanentlyCached(s32 tableType, s32 id) {
+    u32 realId = AudioLoad_GetRealTableIndex(tableType, id);
+    return recomputil_u32_hashset_contains(permanentCache, tableType << 24 | realId);
+}
+
 /* Pop most-recent persistent entry of tableType (LIFO). This is how the game stops sequences —
  * it pops the font/seq from persistent cache, marking it unloaded and discarding font data. */
 RECOMP_PATCH void AudioHeap_PopPersistentCache(s32 tableType) {
@@ -0,0 +1,194 @@
+#include <core/residency.h>
+#include <recomp/modding.h>
+#include <recomp/recomputils.h>
+#include <utils/dynamicdataarray.h>
+#include <core/load_status.h>
+#include <core/soundfont.h>
+
+/*
+ * residency.c — LRU eviction of sequences and soundfonts copied into mod memory.
+ *
+ * Once a sequence or soundfont is loaded from ROM or a DMA callback it is relocated into
+ * recomp_alloc memory and the table entry's romAddr is swapped for that pointer. Without
+ * eviction these copies live forever, so packs that cycle through many tracks grow without bound.
+ *
+ * Every such copy is tracked here together with its original device address. Each audio update
+ * refreshes the last-use frame of entries still referenced by an enabled sequence player (its
+ * sequence data, default font or any channel font). When the tracked total exceeds the budget,
+ * the least recently used entries that have been idle for RESIDENCY_MIN_IDLE_FRAMES are evicted:
+ * romAddr is restored, the fake caches forget the entry and its load status is reset, so the next
+ * use reloads and relocates it like the first time.
+ *
+ * Never evicted: data that was already in RAM (KSEG0 romAddr), permanently cached entries, fonts
+ * with queued load-time changes or edited in place after loading, and entries whose table entry
+ * was replaced since they loaded.
+ */
+
+#define RESIDENCY_DEFAULT_CAPACITY 32
+#define RESIDENCY_MIN_IDLE_FRAMES 600 // Audio updates, roughly ten seconds
+
+typedef struct ResidentEntry {
+    s32 tableType;
+    s32 id;
+    uintptr_t devAddr;  // Original romAddr, restored on eviction
+    void* ramAddr;      // Value stored in romAddr while resident
+    void* allocAddr;    // Allocation holding the data (differs from ramAddr for imported vanilla fonts)
+    size_t size;
+    u32 lastUsed;
+} ResidentEntry;
+
+DynamicDataArray residentEntries;
+size_t residentSize = 0;
+size_t residencyBudget = RESIDENCY_DEFAULT_BUDGET;
+u32 residencyFrame = 0;
+
+extern s32 sExtSeqPlayersSeqId[SEQ_PLAYER_MAX];
+extern AudioTable* AudioLoad_GetLoadTable(s32 tableType);
+
+RECOMP_CALLBACK(".", AudioApi_InitInternal) void AudioApi_ResidencyInit() {
+    DynDataArr_init(&residentEntries, sizeof(ResidentEntry), RESIDENCY_DEFAULT_CAPACITY);
+}
+
+/* Set the number of bytes of evictable sequence/soundfont copies kept in mod memory. 0 disables eviction. */
+RECOMP_EXPORT void AudioApi_SetResidencyBudget(u32 budget) {
+    residencyBudget = budget;
+}
+
+/* Record a sequence or soundfont that was copied into mod memory on load. Data that was already
+ * in RAM is ignored since there is nothing to reload it from. */
+void AudioApi_TrackResident(s32 tableType, s32 id, uintptr_t devAddr, void* ramAddr, void* allocAddr, size_t size) {
+    ResidentEntry entry = { tableType, id, devAddr, ramAddr, allocAddr, size, residencyFrame };
+
+    if (IS_KSEG0(devAddr)) {
+        return;
+    }
+
+    AudioApi_UntrackResident(tableType, id);
+    DynDataArr_push(&residentEntries, &entry);
+    residentSize += size;
+}
+
+/* Stop tracking an entry, keeping its copy resident for good. Used once a font is edited in place. */
+void AudioApi_UntrackResident(s32 tableType, s32 id) {
+    ResidentEntry* entry;
+
+    for (size_t i = 0; i < residentEntries.count; i++) {
+        entry = DynDataArr_get(&residentEntries, i);
+        if (entry->tableType == tableType && entry->id == id) {
+            residentSize -= entry->size;
+            DynDataArr_removeByIndex(&residentEntries, i);
+            return;
+        }
+    }
+}
+
+static bool AudioApi_IsSeqPlayerUsingFont(SequencePlayer* seqPlayer, s32 fontId) {
+    SequenceChannel* channel;
+
+    if (seqPlayer->defaultFont == fontId) {
+        return true;
+    }
+    for (s32 i = 0; i < SEQ_NUM_CHANNELS; i++) {
+        channel = seqPlayer->channels[i];
+        if (channel != NULL && channel->enabled && channel->fontId == fontId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool AudioApi_IsResidentInUse(ResidentEntry* entry) {
+    SequencePlayer* seqPlayer;
+
+    if (AudioApi_GetTableEntryLoadStatus(entry->tableType, entry->id) == LOAD_STATUS_IN_PROGRESS) {
+        return true;
+    }
+
+    for (s32 i = 0; i < gAudioCtx.audioBufferParameters.numSequencePlayers; i++) {
+        seqPlayer = &gAudioCtx.seqPlayers[i];
+        if (!seqPlayer->enabled) {
+            continue;
+        }
+        if (entry->tableType == SEQUENCE_TABLE && sExtSeqPlayersSeqId[i] == entry->id) {
+            return true;
+        }
+        if (entry->tableType == FONT_TABLE && AudioApi_IsSeqPlayerUsingFont(seqPlayer, entry->id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool AudioApi_IsResidentEvictable(ResidentEntry* entry) {
+    if (residencyFrame - entry->lastUsed < RESIDENCY_MIN_IDLE_FRAMES) {
+        return false;
+    }
+    if (AudioApi_IsPermanentlyCached(entry->tableType, entry->id)) {
+        return false;
+    }
+    if (entry->tableType == FONT_TABLE && AudioApi_HasQueuedSoundFontChanges(entry->id)) {
+        return false;
+    }
+    return true;
+}
+
+/* Drop the mod memory copy and point the table entry back at its original source. */
+static void AudioApi_EvictResident(size_t index) {
+    ResidentEntry* entry = DynDataArr_get(&residentEntries, index);
+    AudioTable* table = AudioLoad_GetLoadTable(entry->tableType);
+
+    // The entry was replaced or restored since it loaded, someone else may still hold this memory
+    if (table->entries[entry->id].romAddr != (uintptr_t)entry->ramAddr) {
+        residentSize -= entry->size;
+        DynDataArr_removeByIndex(&residentEntries, index);
+        return;
+    }
+
+    if (entry->tableType == FONT_TABLE) {
+        // Release any notes still holding instruments from this font
+        AudioHeap_DiscardFont(entry->id);
+        if (entry->ramAddr != entry->allocAddr) {
+            AudioApi_FreeSoundFont(entry->ramAddr);
+        }
+    }
+
+    table->entries[entry->id].romAddr = entry->devAddr;
+    AudioApi_DropFakeCache(entry->tableType, entry->id);
+    AudioApi_SetTableEntryLoadStatus(entry->tableType, entry->id, LOAD_STATUS_NOT_LOADED);
+    recomp_free(entry->allocAddr);
+
+    residentSize -= entry->size;
+    DynDataArr_removeByIndex(&residentEntries, index);
+}
+
+/* Called once per audio update. Refreshes LRU timestamps and evicts idle entries over budget. */
+void AudioApi_ResidencyUpdate() {
+    ResidentEntry* entry;
+    size_t oldest;
+    u32 oldestAge;
+
+    residencyFrame++;
+
+    for (size_t i = 0; i < residentEntries.count; i++) {
+        entry = DynDataArr_get(&residentEntries, i);
+        if (AudioApi_IsResidentInUse(entry)) {
+            entry->lastUsed = residencyFrame;
+        }
+    }
+
+    while (residencyBudget != 0 && residentSize > residencyBudget) {
+        oldest = residentEntries.count;
+        oldestAge = 0;
+        for (size_t i = 0; i < residentEntries.count; i++) {
+            entry = DynDataArr_get(&residentEntries, i);
+            if (AudioApi_IsResidentEvictable(entry) && residencyFrame - entry->lastUsed >= oldestAge) {
+                oldest = i;
+                oldestAge = residencyFrame - entry->lastUsed;
+            }
+        }
+        if (oldest == residentEntries.count) {
+            break;
+        }
+        AudioApi_EvictResident(oldest);
+    }
+}
@@ -6,6 +6,7 @@
 #include <core/heap.h>
 #include <core/init.h>
 #include <core/load_status.h>
+#include <core/residency.h>
 #include <core/sequence_functions.h>
 
 /**
@@ -41,7 +42,8 @@
  * == Sequence Loading / Relocation ==
  *   AudioApi_RelocateSequence (callback on AudioApi_SequenceLoadedInternal):
  *   - If loaded into audio heap temp buffer: copies to persistent recomp_alloc'd memory, frees buffer.
- *   - If loaded from ROM (not KSEG0): updates romAddr to point to permanent RAM copy.
+ *   - If loaded from ROM (not KSEG0): updates romAddr to point to the RAM copy and hands it to
+ *     residency.c, which may evict it when idle and restore the original romAddr.
  *   - Fires AudioApi_SequenceLoaded event for mod hooks to post-process sequence data.
  *
  * == Exported API Summary ==
@@ -307,8 +309,8 @@ void AudioApi_SequenceQueueDrain(RecompQueueCmd* cmd) {
     }
 }
 
-/* Post-load hook: relocates sequence data from audio heap temp buffer to persistent mod memory.
- * Also updates romAddr for ROM-loaded sequences to point to the persistent copy.
+/* Post-load hook: relocates sequence data from audio heap temp buffer to mod memory.
+ * Also updates romAddr for ROM-loaded sequences to point to the copy and tracks it for eviction.
  * Finally fires AudioApi_SequenceLoaded event so mods can patch sequence data in-place. */
 RECOMP_CALLBACK(".", AudioApi_SequenceLoadedInternal) void AudioApi_RelocateSequence(s32 seqId, void** ramAddrPtr) {
     if (IS_AUDIO_HEAP_MEMORY(*ramAddrPtr)) {
@@ -320,6 +322,8 @@ RECOMP_CALLBACK(".", AudioApi_SequenceLoadedInternal) void AudioApi_RelocateSequ
     }
 
     if (!IS_KSEG0(gAudioCtx.sequenceTable->entries[seqId].romAddr)) {
+        AudioApi_TrackResident(SEQUENCE_TABLE, seqId, gAudioCtx.sequenceTable->entries[seqId].romAddr,
+                               *ramAddrPtr, *ramAddrPtr, gAudioCtx.sequenceTable->entries[seqId].size);
         gAudioCtx.sequenceTable->entries[seqId].romAddr = (uintptr_t)(*ramAddrPtr);
     }
 
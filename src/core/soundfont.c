@@ -9,6 +9,7 @@
 #include <core/init.h>
 #include <core/load.h>
 #include <core/load_status.h>
+#include <core/residency.h>
 
 /**
  * SoundFont Public API - Create, modify, and manage N64 audio soundfont data for recomp mods.
@@ -34,18 +35,29 @@
  *   [2..2+numInstruments-1] = offsets to instruments (SOUNDFONT_INSTRUMENT_OFFSET = 2)
  *   All offsets are relative to font base; RELOC_TO_RAM converts offset -> absolute pointer.
  *
+ * PACKED FONT LAYOUT (SOUNDFONT_PACKED, built by tools/pack_soundfont.py):
+ *   CustomSoundFont header padded to SOUNDFONT_PACKED_HEADER_SIZE, followed by a vanilla font image.
+ *   The header carries the counts/sample banks and its list pointers are offsets into the image,
+ *   so a whole instrument pack loads with one allocation and is relocated in one pass.
+ *
  * MEMORY OWNERSHIP:
  *   - All Add/Replace API calls deep-copy inputs (AudioApi_Copy*) so caller retains ownership.
+ *   - Imported vanilla fonts are copy-on-write: the font image is moved out of the load buffer in
+ *     one copy and its drums/sfx/instruments are referenced in place. The CustomSoundFont lists
+ *     point into the image (flagged in sharedLists) until an Add call needs to grow them, and a
+ *     Replace only swaps in the caller's copy for the touched entry.
  *   - Sample copies are deduplicated via FNV-32a hash -> sampleHashmap (ADPCM codecs only).
  *   - Samples are ref-counted; AudioApi_FreeSample only frees when refcount hits 0.
- *   - Dynamic arrays (instruments/drums/sfx) grow by doubling capacity when full.
+ *   - Dynamic arrays (instruments/drums/sfx) grow by doubling capacity when full. Shared lists
+ *     are copied into their own allocation on first growth and never freed.
  *   - Global soundfont tables also double (soundFontTable, soundFontList, loadStatus).
  *   - IS_RECOMP_ALLOC guards prevent freeing pointers not owned by recomp_alloc.
  *   - IS_AUDIO_HEAP_MEMORY guards trigger copy-out from transient audio heap during relocation.
  *
  * KEY PATCHED FUNCTION:
  *   AudioLoad_RelocateFont (RECOMP_PATCH) - Intercepts vanilla font loading. For SOUNDFONT_VANILLA
- *   type, imports into CustomSoundFont, applies queued changes, then relocates all pointers
+ *   type, moves the font image into mod memory, imports it into a CustomSoundFont without copying
+ *   its entries, applies queued changes, then relocates all pointers in place
  *   (drums/sfx/instruments/samples/envelopes/loops/books). Replaces the table entry's romAddr
  *   with the permanent CustomSoundFont pointer. Fires AudioApi_SoundFontLoaded event.
  *
@@ -140,7 +152,7 @@ RECOMP_CALLBACK(".", AudioApi_ReadyInternal) void AudioApi_SoundFontReady() {
 }
 
 /* Register a new soundfont entry. Returns fontId or -1 on failure. Grows table if needed.
- * If entry->romAddr is a CustomSoundFont (IS_KSEG0 + SOUNDFONT_CUSTOM), packs metadata into
+ * If entry->romAddr is a CustomSoundFont or packed blob (IS_KSEG0 + not SOUNDFONT_VANILLA), packs metadata into
  * shortData1/2/3 fields (sampleBanks, instrument/drum counts, sfx count). */
 RECOMP_EXPORT s32 AudioApi_AddSoundFont(AudioTableEntry* entry) {
     if (gAudioApiInitPhase == AUDIOAPI_INIT_NOT_READY) {
@@ -159,7 +171,7 @@ RECOMP_EXPORT s32 AudioApi_AddSoundFont(AudioTableEntry* entry) {
     gAudioCtx.soundFontTable->entries[newFontId] = *entry;
 
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
-    if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+    if (IS_KSEG0(entry->romAddr) && soundFont->type != SOUNDFONT_VANILLA) {
         entry->shortData1 = (soundFont->sampleBank1 << 8) | soundFont->sampleBank2;
         entry->shortData2 = (soundFont->numInstruments << 8) | soundFont->numDrums;
         entry->shortData3 = soundFont->numSfx;
@@ -192,7 +204,7 @@ RECOMP_EXPORT void AudioApi_ReplaceSoundFont(s32 fontId, AudioTableEntry* entry)
     gAudioCtx.soundFontTable->entries[fontId] = *entry;
 
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
-    if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+    if (IS_KSEG0(entry->romAddr) && soundFont->type != SOUNDFONT_VANILLA) {
         entry->shortData1 = (soundFont->sampleBank1 << 8) | soundFont->sampleBank2;
         entry->shortData2 = (soundFont->numInstruments << 8) | soundFont->numDrums;
         entry->shortData3 = soundFont->numSfx;
@@ -282,64 +294,64 @@ RECOMP_EXPORT s32 AudioApi_CreateEmptySoundFont() {
     return fontId;
 }
 
-/* Convert raw vanilla ROM font data (uintptr_t array) into a heap-allocated CustomSoundFont.
- * Copies instrument/drum/sfx pointer arrays from the ROM layout. Does NOT relocate pointers;
- * the caller must relocate drums[i], instruments[i], envelopes, samples etc. afterwards.
- * Capacities auto-grow (doubling) to fit the actual counts. */
+/* Wrap raw vanilla ROM font data (uintptr_t array) in a heap-allocated CustomSoundFont.
+ * Nothing is copied: the instrument/drum/sfx lists point straight into fontData and are flagged
+ * in sharedLists, so fontData must outlive the returned font. Does NOT relocate pointers; the
+ * caller must relocate drums[i], instruments[i], envelopes, samples etc. afterwards. */
 CustomSoundFont* AudioApi_ImportVanillaSoundFontInternal(uintptr_t* fontData, u8 sampleBank1, u8 sampleBank2,
                                                          u8 numInstruments, u8 numDrums, u16 numSfx) {
-    CustomSoundFont* soundFont = NULL;
+    CustomSoundFont* soundFont;
     size_t size;
 
     size = sizeof(CustomSoundFont);
     soundFont = recomp_alloc(size);
-    if (!soundFont) goto cleanup;
+    if (!soundFont) {
+        return NULL;
+    }
     Lib_MemSet(soundFont, 0, size);
 
     soundFont->type = SOUNDFONT_CUSTOM;
+    soundFont->sharedLists = SOUNDFONT_SHARED_INSTRUMENTS | SOUNDFONT_SHARED_DRUMS | SOUNDFONT_SHARED_SFX;
     soundFont->sampleBank1 = sampleBank1;
     soundFont->sampleBank2 = sampleBank2;
     soundFont->numInstruments = numInstruments;
     soundFont->numDrums = numDrums;
     soundFont->numSfx = numSfx;
-    soundFont->instrumentsCapacity = SOUNDFONT_DEFAULT_INSTRUMENT_CAPACITY;
-    soundFont->drumsCapacity = SOUNDFONT_DEFAULT_DRUM_CAPACITY;
-    soundFont->sfxCapacity = SOUNDFONT_DEFAULT_SFX_CAPACITY;
-
-    while (numInstruments > soundFont->instrumentsCapacity) soundFont->instrumentsCapacity <<= 1;
-    size = soundFont->instrumentsCapacity * sizeof(uintptr_t);
-    soundFont->instruments = recomp_alloc(size);
-    if (!soundFont->instruments) goto cleanup;
-    Lib_MemSet(soundFont->instruments, 0, size);
-    Lib_MemCpy(soundFont->instruments, fontData + SOUNDFONT_INSTRUMENT_OFFSET,
-               numInstruments * sizeof(uintptr_t));
 
-    while (numDrums > soundFont->drumsCapacity) soundFont->drumsCapacity <<= 1;
-    size = soundFont->drumsCapacity * sizeof(uintptr_t);
-    soundFont->drums = recomp_alloc(size);
-    if (!soundFont->drums) goto cleanup;
-    Lib_MemSet(soundFont->drums, 0, size);
-    Lib_MemCpy(soundFont->drums, (void*)RELOC_TO_RAM(fontData[0], fontData),
-               numDrums * sizeof(uintptr_t));
+    // Shared lists are sized exactly, the first Add will copy them out and double the capacity
+    soundFont->instrumentsCapacity = numInstruments;
+    soundFont->drumsCapacity = numDrums;
+    soundFont->sfxCapacity = numSfx;
 
-    while (numSfx > soundFont->sfxCapacity) soundFont->sfxCapacity <<= 1;
-    size = soundFont->sfxCapacity * sizeof(SoundEffect);
-    soundFont->soundEffects = recomp_alloc(size);
-    if (!soundFont->soundEffects) goto cleanup;
-    Lib_MemSet(soundFont->soundEffects, 0, size);
-    Lib_MemCpy(soundFont->soundEffects, (void*)RELOC_TO_RAM(fontData[1], fontData),
-               numSfx * sizeof(SoundEffect));
+    soundFont->instruments = (Instrument**)(fontData + SOUNDFONT_INSTRUMENT_OFFSET);
+    soundFont->drums = (Drum**)RELOC_TO_RAM(fontData[0], fontData);
+    soundFont->soundEffects = (SoundEffect*)RELOC_TO_RAM(fontData[1], fontData);
 
     return soundFont;
+}
 
- cleanup:
-    AudioApi_FreeSoundFont(soundFont);
-    return NULL;
+/* Turn a SOUNDFONT_PACKED blob into a CustomSoundFont in place. The header already has the
+ * CustomSoundFont layout with list offsets relative to the image behind it, so only the three
+ * lists are relocated here. They stay shared with the image; drums/sfx/instruments are relocated
+ * by the caller in the same pass as vanilla fonts. */
+void AudioApi_UnpackSoundFontInternal(CustomSoundFont* soundFont) {
+    void* image = (u8*)soundFont + SOUNDFONT_PACKED_HEADER_SIZE;
+
+    soundFont->type = SOUNDFONT_CUSTOM;
+    soundFont->sharedLists = SOUNDFONT_SHARED_INSTRUMENTS | SOUNDFONT_SHARED_DRUMS | SOUNDFONT_SHARED_SFX;
+    soundFont->instrumentsCapacity = soundFont->numInstruments;
+    soundFont->drumsCapacity = soundFont->numDrums;
+    soundFont->sfxCapacity = soundFont->numSfx;
+
+    soundFont->instruments = (Instrument**)RELOC_TO_RAM(soundFont->instruments, image);
+    soundFont->drums = (Drum**)RELOC_TO_RAM(soundFont->drums, image);
+    soundFont->soundEffects = (SoundEffect*)RELOC_TO_RAM(soundFont->soundEffects, image);
 }
 
 /* Public: Import vanilla font data, relocate all internal pointers (drums->envelope->sample->
  * loop/book, sfx->sample->loop/book, instruments->{low,normal,high}PitchSample->loop/book),
- * then register as new CustomSoundFont. Returns fontId or -1. */
+ * then register as new CustomSoundFont. fontData is referenced in place and must stay valid.
+ * Returns fontId or -1. */
 RECOMP_EXPORT s32 AudioApi_ImportVanillaSoundFont(uintptr_t* fontData, u8 sampleBank1, u8 sampleBank2,
                                                   u8 numInstruments, u8 numDrums, u16 numSfx) {
     AudioTableEntry entry;
@@ -458,6 +470,7 @@ RECOMP_EXPORT void AudioApi_SetSoundFontSampleBank(s32 fontId, s32 bankNum, s32
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
 
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         if (bankNum == 1) {
             soundFont->sampleBank1 = bankId;
         } else if (bankNum == 2) {
@@ -503,6 +516,7 @@ RECOMP_EXPORT s32 AudioApi_AddInstrument(s32 fontId, Instrument* instrument) {
 
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         instId = AudioApi_AddInstrumentInternal(soundFont, copy);
     } else {
         RecompQueue_Push(soundFontLoadQueue, AUDIOAPI_CMD_OP_ADD_INSTRUMENT, fontId, instId, (void**)&copy);
@@ -552,6 +566,7 @@ RECOMP_EXPORT s32 AudioApi_AddDrum(s32 fontId, Drum* drum) {
 
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         drumId = AudioApi_AddDrumInternal(soundFont, copy);
     } else {
         RecompQueue_Push(soundFontLoadQueue, AUDIOAPI_CMD_OP_ADD_DRUM, fontId, drumId, (void**)&copy);
@@ -602,6 +617,7 @@ RECOMP_EXPORT s32 AudioApi_AddSoundEffect(s32 fontId, SoundEffect* sfx) {
 
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         sfxId = AudioApi_AddSoundEffectInternal(soundFont, copy);
     } else {
         RecompQueue_Push(soundFontLoadQueue, AUDIOAPI_CMD_OP_ADD_SOUNDEFFECT, fontId, sfxId, (void**)&copy);
@@ -645,6 +661,7 @@ RECOMP_EXPORT void AudioApi_ReplaceDrum(s32 fontId, s32 drumId, Drum* drum) {
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
 
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         AudioApi_ReplaceDrumInternal(soundFont, drumId, copy);
     } else {
         RecompQueue_PushIfNotQueued(soundFontLoadQueue, AUDIOAPI_CMD_OP_REPLACE_DRUM,
@@ -682,6 +699,7 @@ RECOMP_EXPORT void AudioApi_ReplaceSoundEffect(s32 fontId, s32 sfxId, SoundEffec
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
 
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         AudioApi_ReplaceSoundEffectInternal(soundFont, sfxId, copy);
     } else {
         RecompQueue_PushIfNotQueued(soundFontLoadQueue, AUDIOAPI_CMD_OP_REPLACE_SOUNDEFFECT,
@@ -718,6 +736,7 @@ RECOMP_EXPORT void AudioApi_ReplaceInstrument(s32 fontId, s32 instId, Instrument
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
 
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         AudioApi_ReplaceInstrumentInternal(soundFont, instId, copy);
     } else {
         RecompQueue_PushIfNotQueued(soundFontLoadQueue, AUDIOAPI_CMD_OP_REPLACE_INSTRUMENT,
@@ -743,6 +762,7 @@ void AudioApi_SoundFontQueueDrain(RecompQueueCmd* cmd) {
 
     CustomSoundFont* soundFont = (CustomSoundFont*)entry->romAddr;
     if (IS_KSEG0(entry->romAddr) && soundFont->type == SOUNDFONT_CUSTOM) {
+        AudioApi_UntrackResident(FONT_TABLE, fontId); // Edited in place, must not be reloaded
         // If the font is in memory and is a CustomSoundFont, we can call the replace command now
         switch (cmd->op) {
         case AUDIOAPI_CMD_OP_SET_SAMPLEBANK:
@@ -774,6 +794,17 @@ void AudioApi_SoundFontQueueDrain(RecompQueueCmd* cmd) {
     }
 }
 
+/* True if soundFontLoadQueue holds changes for fontId. Such fonts must stay resident since the
+ * queued copies are applied to the loaded font and never freed. */
+bool AudioApi_HasQueuedSoundFontChanges(s32 fontId) {
+    for (s32 i = 0; i < soundFontLoadQueue->numEntries; i++) {
+        if (soundFontLoadQueue->entries[i].arg0 == (u32)fontId) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /* Scan soundFontLoadQueue for all entries matching fontId and apply them to the
  * now-loaded CustomSoundFont. Called from AudioLoad_RelocateFont for vanilla fonts. */
 void AudioApi_ApplySoundFontChanges(s32 fontId, CustomSoundFont* customSoundFont) {
@@ -810,14 +841,16 @@ void AudioApi_ApplySoundFontChanges(s32 fontId, CustomSoundFont* customSoundFont
  * RECOMP_PATCH: Replaces vanilla AudioLoad_RelocateFont.
  *
  * Called by the audio engine when a soundfont finishes loading from ROM.
- * For SOUNDFONT_VANILLA: imports into CustomSoundFont via ImportVanillaSoundFontInternal,
- * then applies any queued load-queue changes (AudioApi_ApplySoundFontChanges).
+ * For SOUNDFONT_VANILLA/PACKED data sitting in the transient audio heap load buffer, first copies
+ * the whole font image to recomp_alloc memory in one go and frees the buffer.
+ * For SOUNDFONT_VANILLA: wraps the image in a CustomSoundFont via ImportVanillaSoundFontInternal
+ * (lists are shared, not copied) and applies any queued load-queue changes (AudioApi_ApplySoundFontChanges).
+ * For SOUNDFONT_PACKED: turns the blob header into the CustomSoundFont in place via
+ * UnpackSoundFontInternal and applies queued changes; items are relocated against the image.
  * Then for ALL fonts: relocates every drum/sfx/instrument and their nested
- * envelopes + samples (via AudioLoad_RelocateSample). Items in the transient audio heap
- * (IS_AUDIO_HEAP_MEMORY) are deep-copied out to permanent recomp_alloc memory.
+ * envelopes + samples (via AudioLoad_RelocateSample) in place.
  * Finally updates gAudioCtx.soundFontList[fontId] with relocated pointers/counts,
- * frees transient buffers, sets entry->romAddr to the permanent CustomSoundFont,
- * and fires the AudioApi_SoundFontLoaded event.
+ * sets entry->romAddr to the permanent CustomSoundFont, and fires the AudioApi_SoundFontLoaded event.
  */
 RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, SampleBankRelocInfo* sampleBankReloc) {
     CustomSoundFont* fontData = (CustomSoundFont*)fontDataStartAddr;
@@ -825,8 +858,24 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
     Instrument* inst;
     Drum* drum;
     SoundEffect* soundEffect;
+    void* fontImage;
+    void* fontAlloc = fontDataStartAddr;
     s32 i;
 
+    // Move the whole font image out of the transient load buffer with a single copy. Everything
+    // inside it is then relocated and referenced in place instead of being copied one by one.
+    if (fontData->type != SOUNDFONT_CUSTOM && IS_AUDIO_HEAP_MEMORY(fontDataStartAddr)) {
+        fontImage = recomp_alloc(entry->size);
+        if (!fontImage) {
+            recomp_printf("AudioApi: Error allocating soundfont %d\n", fontId);
+            return;
+        }
+        Lib_MemCpy(fontImage, fontDataStartAddr, entry->size);
+        AudioHeap_LoadBufferFree(FONT_TABLE, fontId);
+        fontDataStartAddr = fontAlloc = fontImage;
+        fontData = (CustomSoundFont*)fontImage;
+    }
+
     // We've just loaded this font from ROM or callback, so apply any changes from our load queue
     if (fontData->type == SOUNDFONT_VANILLA) {
         u8 sampleBank1 = (entry->shortData1 & 0xFF00) >> 8;
@@ -837,7 +886,16 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
 
         fontData = AudioApi_ImportVanillaSoundFontInternal((uintptr_t*)fontDataStartAddr, sampleBank1, sampleBank2,
                                                            numInstruments, numDrums, numSfx);
+        if (!fontData) {
+            recomp_printf("AudioApi: Error importing soundfont %d\n", fontId);
+            return;
+        }
 
+        AudioApi_ApplySoundFontChanges(fontId, fontData);
+    } else if (fontData->type == SOUNDFONT_PACKED) {
+        // The blob header becomes the CustomSoundFont, items are relocated against the image below
+        fontDataStartAddr = (u8*)fontData + SOUNDFONT_PACKED_HEADER_SIZE;
+        AudioApi_UnpackSoundFontInternal(fontData);
         AudioApi_ApplySoundFontChanges(fontId, fontData);
     }
 
@@ -852,10 +910,6 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
         drum->isRelocated = true;
 
         AudioLoad_RelocateSample(&drum->tunedSample, fontDataStartAddr, sampleBankReloc);
-
-        if (IS_AUDIO_HEAP_MEMORY(drum)) {
-            fontData->drums[i] = AudioApi_CopyDrum(drum);
-        }
     }
 
     for (i = 0; i < fontData->numSfx; i++) {
@@ -865,10 +919,6 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
         }
 
         AudioLoad_RelocateSample(&soundEffect->tunedSample, fontDataStartAddr, sampleBankReloc);
-
-        if (IS_AUDIO_HEAP_MEMORY(soundEffect->tunedSample.sample)) {
-            soundEffect->tunedSample.sample = AudioApi_CopySample(soundEffect->tunedSample.sample);
-        }
     }
 
     for (i = 0; i < MIN(fontData->numInstruments, SOUNDFONT_MAX_INSTRUMENTS); i++) {
@@ -889,10 +939,6 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
         if (inst->normalRangeHi != 0x7F) {
             AudioLoad_RelocateSample(&inst->highPitchTunedSample, fontDataStartAddr, sampleBankReloc);
         }
-
-        if (IS_AUDIO_HEAP_MEMORY(inst)) {
-            fontData->instruments[i] = AudioApi_CopyInstrument(inst);
-        }
     }
 
     // Update counts after applying any queued changes
@@ -905,15 +951,10 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
     gAudioCtx.soundFontList[fontId].soundEffects = fontData->soundEffects;
     gAudioCtx.soundFontList[fontId].instruments = fontData->instruments;
 
-    // Free temporary memory
-    if (IS_AUDIO_HEAP_MEMORY(fontDataStartAddr)) {
-        AudioHeap_LoadBufferFree(FONT_TABLE, fontId);
-    } else if (IS_DMA_CALLBACK_DEV_ADDR(entry->romAddr)) {
-        // recomp_free(fontDataStartAddr);
-    }
-
-    // If this soundfont was loaded from ROM or a callback, update the entry's romAddr to our new permanent memory.
+    // If this soundfont was loaded from ROM or a callback, update the entry's romAddr to our new memory.
+    // It stays there until residency.c evicts it and restores the original address.
     if (!IS_KSEG0(entry->romAddr)) {
+        AudioApi_TrackResident(FONT_TABLE, fontId, entry->romAddr, fontData, fontAlloc, entry->size);
         entry->romAddr = (uintptr_t)fontData;
     }
 
@@ -924,7 +965,8 @@ RECOMP_PATCH void AudioLoad_RelocateFont(s32 fontId, void* fontDataStartAddr, Sa
 /**
  * RECOMP_PATCH: Relocate a TunedSample's Sample pointer and its sub-pointers (loop, book).
  * Resolves sample bank base address: medium==0 -> bank1, medium==1 -> bank2.
- * For DMA callback addresses, wraps via AudioApi_AddDmaSubCallback instead of direct reloc.
+ * For DMA callback addresses, wraps via AudioApi_AddDmaSubCallback instead of direct reloc,
+ * with the sample's bank offset and size as arg1/arg2.
  * Sets sample->isRelocated=true to prevent double-relocation.
  */
 RECOMP_PATCH void AudioLoad_RelocateSample(TunedSample* tunedSample, void* fontData, SampleBankRelocInfo* sampleBankReloc) {
@@ -947,7 +989,8 @@ RECOMP_PATCH void AudioLoad_RelocateSample(TunedSample* tunedSample, void* fontD
         }
 
         if (IS_DMA_CALLBACK_DEV_ADDR(baseAddr)) {
-            sample->sampleAddr = (u8*)AudioApi_AddDmaSubCallback(baseAddr, (uintptr_t)sample->sampleAddr, 0);
+            // Pass the sample size along so native sample banks can prefetch the whole sample
+            sample->sampleAddr = (u8*)AudioApi_AddDmaSubCallback(baseAddr, (uintptr_t)sample->sampleAddr, sample->size);
         } else {
             sample->sampleAddr = RELOC_TO_RAM(sample->sampleAddr, baseAddr);
         }
@@ -1023,14 +1066,19 @@ bool AudioApi_GrowSoundFontTables() {
     return false;
 }
 
-/* Double a CustomSoundFont's instruments array capacity. */
+/* Double a CustomSoundFont's instruments array capacity. A shared list is copied out of the
+ * font image here (copy-on-write) and the image is left untouched. */
 bool AudioApi_GrowInstrumentList(CustomSoundFont* soundFont) {
     Instrument** newInstList = NULL;
     u16 oldCapacity = soundFont->instrumentsCapacity;
-    u16 newCapacity = soundFont->instrumentsCapacity << 1;
+    u16 newCapacity = MIN(MAX(oldCapacity << 1, SOUNDFONT_DEFAULT_INSTRUMENT_CAPACITY), SOUNDFONT_MAX_INSTRUMENTS);
     size_t oldSize = sizeof(uintptr_t) * oldCapacity;
     size_t newSize = sizeof(uintptr_t) * newCapacity;
 
+    if (newCapacity <= oldCapacity) {
+        return false;
+    }
+
     newInstList = recomp_alloc(newSize);
     if (!newInstList) {
         return false;
@@ -1038,7 +1086,9 @@ bool AudioApi_GrowInstrumentList(CustomSoundFont* soundFont) {
     Lib_MemSet(newInstList, 0, newSize);
     Lib_MemCpy(newInstList, soundFont->instruments, oldSize);
 
-    if (IS_RECOMP_ALLOC(soundFont->instruments)) {
+    if (soundFont->sharedLists & SOUNDFONT_SHARED_INSTRUMENTS) {
+        soundFont->sharedLists &= ~SOUNDFONT_SHARED_INSTRUMENTS;
+    } else if (IS_RECOMP_ALLOC(soundFont->instruments)) {
         recomp_free(soundFont->instruments);
     }
     soundFont->instrumentsCapacity = newCapacity;
@@ -1046,14 +1096,19 @@ bool AudioApi_GrowInstrumentList(CustomSoundFont* soundFont) {
     return true;
 }
 
-/* Double a CustomSoundFont's drums array capacity. */
+/* Double a CustomSoundFont's drums array capacity, copying a shared list out of the font image.
+ * Capped at 0xFF since numDrums and drumsCapacity are u8. */
 bool AudioApi_GrowDrumList(CustomSoundFont* soundFont) {
     Drum** newDrumList = NULL;
     u16 oldCapacity = soundFont->drumsCapacity;
-    u16 newCapacity = soundFont->drumsCapacity << 1;
+    u16 newCapacity = MIN(MAX(oldCapacity << 1, SOUNDFONT_DEFAULT_DRUM_CAPACITY), 0xFF);
     size_t oldSize = sizeof(uintptr_t) * oldCapacity;
     size_t newSize = sizeof(uintptr_t) * newCapacity;
 
+    if (newCapacity <= oldCapacity) {
+        return false;
+    }
+
     newDrumList = recomp_alloc(newSize);
     if (!newDrumList) {
         return false;
@@ -1061,7 +1116,9 @@ bool AudioApi_GrowDrumList(CustomSoundFont* soundFont) {
     Lib_MemSet(newDrumList, 0, newSize);
     Lib_MemCpy(newDrumList, soundFont->drums, oldSize);
 
-    if (IS_RECOMP_ALLOC(soundFont->drums)) {
+    if (soundFont->sharedLists & SOUNDFONT_SHARED_DRUMS) {
+        soundFont->sharedLists &= ~SOUNDFONT_SHARED_DRUMS;
+    } else if (IS_RECOMP_ALLOC(soundFont->drums)) {
         recomp_free(soundFont->drums);
     }
     soundFont->drumsCapacity = newCapacity;
@@ -1069,14 +1126,18 @@ bool AudioApi_GrowDrumList(CustomSoundFont* soundFont) {
     return true;
 }
 
-/* Double a CustomSoundFont's soundEffects array capacity. */
+/* Double a CustomSoundFont's soundEffects array capacity, copying a shared list out of the font image. */
 bool AudioApi_GrowSoundEffectList(CustomSoundFont* soundFont) {
     SoundEffect* newSfxList = NULL;
     u16 oldCapacity = soundFont->sfxCapacity;
-    u16 newCapacity = soundFont->sfxCapacity << 1;
+    u16 newCapacity = MIN(MAX(oldCapacity << 1, SOUNDFONT_DEFAULT_SFX_CAPACITY), SOUNDFONT_MAX_SFX);
     size_t oldSize = sizeof(SoundEffect) * oldCapacity;
     size_t newSize = sizeof(SoundEffect) * newCapacity;
 
+    if (newCapacity <= oldCapacity) {
+        return false;
+    }
+
     newSfxList = recomp_alloc(newSize);
     if (!newSfxList) {
         return false;
@@ -1084,7 +1145,9 @@ bool AudioApi_GrowSoundEffectList(CustomSoundFont* soundFont) {
     Lib_MemSet(newSfxList, 0, newSize);
     Lib_MemCpy(newSfxList, soundFont->soundEffects, oldSize);
 
-    if (IS_RECOMP_ALLOC(soundFont->soundEffects)) {
+    if (soundFont->sharedLists & SOUNDFONT_SHARED_SFX) {
+        soundFont->sharedLists &= ~SOUNDFONT_SHARED_SFX;
+    } else if (IS_RECOMP_ALLOC(soundFont->soundEffects)) {
         recomp_free(soundFont->soundEffects);
     }
     soundFont->sfxCapacity = newCapacity;
@@ -1298,12 +1361,19 @@ Sample* AudioApi_CopySample(Sample* src) {
     return copy;
 }
 
-/* Free a CustomSoundFont and its arrays (does NOT free individual instruments/drums/samples). */
+/* Free a CustomSoundFont and its own arrays (does NOT free shared lists or individual
+ * instruments/drums/samples). */
 void AudioApi_FreeSoundFont(CustomSoundFont* soundFont) {
     if (!soundFont) return;
-    if (soundFont->instruments) recomp_free(soundFont->instruments);
-    if (soundFont->drums) recomp_free(soundFont->drums);
-    if (soundFont->soundEffects) recomp_free(soundFont->soundEffects);
+    if (soundFont->instruments && !(soundFont->sharedLists & SOUNDFONT_SHARED_INSTRUMENTS)) {
+        recomp_free(soundFont->instruments);
+    }
+    if (soundFont->drums && !(soundFont->sharedLists & SOUNDFONT_SHARED_DRUMS)) {
+        recomp_free(soundFont->drums);
+    }
+    if (soundFont->soundEffects && !(soundFont->sharedLists & SOUNDFONT_SHARED_SFX)) {
+        recomp_free(soundFont->soundEffects);
+    }
     recomp_free(soundFont);
 }
 
@@ -0,0 +1,158 @@
+#include <extlib/decoder/channel_mixer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace Decoder {
+
+constexpr float CENTER_GAIN = 0.70710678f;
+constexpr float SURROUND_GAIN = 0.70710678f;
+
+enum Speaker { FL, FR, FC, LFE, BL, BR, SL, SR };
+
+// Speaker of each track for 5.0, 5.1 and 7.1 files
+static const std::vector<Speaker>& surroundLayout(uint32_t tracks, bool vorbisOrder) {
+    static const std::vector<Speaker> none;
+    static const std::vector<Speaker> wav50 = { FL, FR, FC, BL, BR };
+    static const std::vector<Speaker> wav51 = { FL, FR, FC, LFE, BL, BR };
+    static const std::vector<Speaker> wav71 = { FL, FR, FC, LFE, BL, BR, SL, SR };
+    static const std::vector<Speaker> vorbis50 = { FL, FC, FR, BL, BR };
+    static const std::vector<Speaker> vorbis51 = { FL, FC, FR, BL, BR, LFE };
+    static const std::vector<Speaker> vorbis71 = { FL, FC, FR, SL, SR, BL, BR, LFE };
+
+    switch (tracks) {
+    case 5: return vorbisOrder ? vorbis50 : wav50;
+    case 6: return vorbisOrder ? vorbis51 : wav51;
+    case 8: return vorbisOrder ? vorbis71 : wav71;
+    default: return none;
+    }
+}
+
+ChannelMixer::ChannelMixer(AudioApiChannelMix mix, uint32_t inTracks, bool vorbisOrder,
+                           const uint32_t* channelMap, uint32_t mapCount)
+    : inTracks(inTracks) {
+
+    if (inTracks == 0) {
+        throw std::invalid_argument("Channel mix of a file without tracks");
+    }
+
+    switch (mix) {
+    case AUDIOAPI_CHANNEL_MIX_STEREO:
+        stemsToStereo();
+        break;
+    case AUDIOAPI_CHANNEL_MIX_MONO:
+        stemsToStereo();
+        stereoToMono();
+        break;
+    case AUDIOAPI_CHANNEL_MIX_SURROUND_STEREO:
+        surroundToStereo(vorbisOrder);
+        break;
+    case AUDIOAPI_CHANNEL_MIX_SURROUND_MONO:
+        surroundToStereo(vorbisOrder);
+        stereoToMono();
+        break;
+    case AUDIOAPI_CHANNEL_MIX_REMAP:
+        if (mapCount == 0 || mapCount > AUDIOAPI_MAX_MIX_TRACKS) {
+            throw std::invalid_argument("Invalid channel map size " + std::to_string(mapCount));
+        }
+
+        outTracks = mapCount;
+        matrix.assign(outTracks * inTracks, 0.0f);
+
+        for (uint32_t out = 0; out < mapCount; out++) {
+            if (channelMap[out] >= inTracks) {
+                throw std::invalid_argument("Invalid channel map track " + std::to_string(channelMap[out]));
+            }
+            gain(out, channelMap[out]) = 1.0f;
+        }
+        break;
+    default:
+        throw std::invalid_argument("Invalid channel mix " + std::to_string(mix));
+    }
+}
+
+// Tracks are stereo pairs like AUDIOAPI_CHANNEL_TYPE_STEREO plays them, summed at unity gain the
+// way stems are meant to be. A single track goes to both sides.
+void ChannelMixer::stemsToStereo() {
+    outTracks = 2;
+    matrix.assign(outTracks * inTracks, 0.0f);
+
+    if (inTracks == 1) {
+        gain(0, 0) = gain(1, 0) = 1.0f;
+        return;
+    }
+
+    for (uint32_t in = 0; in < inTracks; in++) {
+        gain(in & 1, in) = 1.0f;
+    }
+
+    // A trailing odd track has no partner
+    if (inTracks & 1) {
+        gain(0, inTracks - 1) = gain(1, inTracks - 1) = CENTER_GAIN;
+    }
+}
+
+// ITU-R BS.775 style downmix, normalized so a full scale signal on every speaker does not clip.
+// LFE is dropped. Other layouts are treated as stems.
+void ChannelMixer::surroundToStereo(bool vorbisOrder) {
+    const auto& layout = surroundLayout(inTracks, vorbisOrder);
+    if (layout.empty()) {
+        return stemsToStereo();
+    }
+
+    outTracks = 2;
+    matrix.assign(outTracks * inTracks, 0.0f);
+
+    for (uint32_t in = 0; in < inTracks; in++) {
+        switch (layout[in]) {
+        case FL: gain(0, in) = 1.0f; break;
+        case FR: gain(1, in) = 1.0f; break;
+        case FC: gain(0, in) = gain(1, in) = CENTER_GAIN; break;
+        case BL: case SL: gain(0, in) = SURROUND_GAIN; break;
+        case BR: case SR: gain(1, in) = SURROUND_GAIN; break;
+        case LFE: break;
+        }
+    }
+
+    for (uint32_t out = 0; out < outTracks; out++) {
+        float sum = 0;
+        for (uint32_t in = 0; in < inTracks; in++) {
+            sum += gain(out, in);
+        }
+        for (uint32_t in = 0; in < inTracks; in++) {
+            gain(out, in) /= sum;
+        }
+    }
+}
+
+void ChannelMixer::stereoToMono() {
+    std::vector<float> mono(inTracks);
+
+    for (uint32_t in = 0; in < inTracks; in++) {
+        mono[in] = (gain(0, in) + gain(1, in)) * 0.5f;
+    }
+
+    outTracks = 1;
+    matrix = std::move(mono);
+}
+
+void ChannelMixer::process(const int16_t* in, size_t frames, int16_t* out) const {
+    for (size_t i = 0; i < frames; i++) {
+        const int16_t* src = in + i * inTracks;
+
+        for (uint32_t o = 0; o < outTracks; o++) {
+            const float* gains = &matrix[o * inTracks];
+            float acc = 0;
+
+            for (uint32_t t = 0; t < inTracks; t++) {
+                acc += src[t] * gains[t];
+            }
+
+            out[i * outTracks + o] = static_cast<int16_t>(std::clamp(std::lrint(acc), -32768L, 32767L));
+        }
+    }
+}
+
+} // namespace Decoder
@@ -28,6 +28,10 @@ void Mp3::open() {
         throw std::runtime_error("Decoder error: failed to open decoder");
     }
 
+    if (!seekPoints.empty()) {
+        drmp3_bind_seek_table(decoder, static_cast<drmp3_uint32>(seekPoints.size()), seekPoints.data());
+    }
+
     firstOpen = false;
 }
 
@@ -76,6 +80,32 @@ long Mp3::decode(std::vector<int16_t>* buffer, size_t count, size_t offset) {
     return drmp3_read_pcm_frames_s16(decoder, framesToRead, buffer->data());
 }
 
+// About one seek point per second, a seek decodes from the nearest one before it. Scans the whole
+// file, the decoder position is restored afterwards.
+void Mp3::prepareSeek() {
+    if (decoder == nullptr) {
+        throw std::runtime_error("Decoder error: not open");
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (seekTableBuilt) {
+        return;
+    }
+    seekTableBuilt = true;
+
+    auto count = static_cast<drmp3_uint32>(metadata->sampleCount / std::max<uint32_t>(metadata->sampleRate, 1) + 1);
+    seekPoints.resize(count);
+
+    if (!drmp3_calculate_seek_points(decoder, &count, seekPoints.data()) || count == 0) {
+        seekPoints.clear();
+        return;
+    }
+
+    seekPoints.resize(count);
+    drmp3_bind_seek_table(decoder, count, seekPoints.data());
+}
+
 size_t Mp3::onRead(void* datasrc, void* ptr, size_t bytes) {
     auto that = static_cast<Mp3*>(datasrc);
     return that->file->read(ptr, bytes);
@@ -0,0 +1,126 @@
+#include <extlib/decoder/resampler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace Decoder {
+
+// 32 taps at 256 phases, Kaiser window. Passband is flat to ~90% of the lower Nyquist frequency,
+// stopband attenuation is ~80 dB.
+constexpr int TAPS = 32;
+constexpr int HALF_TAPS = TAPS / 2;
+constexpr int PHASES = 256;
+constexpr double KAISER_BETA = 8.0;
+constexpr double CUTOFF = 0.95;
+constexpr int LANES = 8;
+
+static_assert(TAPS % LANES == 0, "TAPS must be a multiple of LANES");
+
+// Zeroth order modified Bessel function of the first kind, for the Kaiser window
+static double bessel0(double x) {
+    double sum = 1.0, term = 1.0;
+
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+
+    return sum;
+}
+
+Resampler::Resampler(uint32_t inRate, uint32_t outRate)
+    : inRate(inRate), outRate(outRate), coefficients((PHASES + 1) * TAPS) {
+
+    if (inRate == 0 || outRate == 0) {
+        throw std::invalid_argument("Invalid sample rate");
+    }
+
+    // Downsampling moves the cutoff down to the output's Nyquist frequency
+    double cutoff = CUTOFF * std::min(1.0, static_cast<double>(outRate) / inRate);
+    double window = bessel0(KAISER_BETA);
+
+    // Phase p is for output positions p/PHASES past an input frame, tap k sits at input frame
+    // k - HALF_TAPS + 1 relative to it. Each phase is normalized to unity gain.
+    for (int phase = 0; phase <= PHASES; phase++) {
+        float* taps = &coefficients[phase * TAPS];
+        double sum = 0;
+
+        for (int k = 0; k < TAPS; k++) {
+            double t = k - HALF_TAPS + 1 - static_cast<double>(phase) / PHASES;
+            double x = t / HALF_TAPS;
+            double sinc = t == 0 ? 1.0 : std::sin(std::numbers::pi * cutoff * t) / (std::numbers::pi * cutoff * t);
+            double kaiser = std::abs(x) >= 1 ? 0 : bessel0(KAISER_BETA * std::sqrt(1 - x * x)) / window;
+
+            taps[k] = static_cast<float>(sinc * kaiser);
+            sum += taps[k];
+        }
+
+        for (int k = 0; k < TAPS; k++) {
+            taps[k] = static_cast<float>(taps[k] / sum);
+        }
+    }
+}
+
+size_t Resampler::toOutput(size_t inFrame) const {
+    return (static_cast<uint64_t>(inFrame) * outRate + inRate / 2) / inRate;
+}
+
+std::pair<int64_t, int64_t> Resampler::inputRange(size_t outStart, size_t count) const {
+    int64_t first = static_cast<uint64_t>(outStart) * inRate / outRate;
+    int64_t last = static_cast<uint64_t>(outStart + count) * inRate / outRate;
+
+    return { first - HALF_TAPS + 1, last + HALF_TAPS + 1 };
+}
+
+void Resampler::process(const int16_t* in, int64_t inStart, size_t inFrames, uint32_t channels,
+                        int16_t* out, size_t outStart, size_t count) const {
+
+    // Planar float copy, so the filter runs over contiguous memory the compiler can vectorize
+    std::vector<float> planar(static_cast<size_t>(channels) * inFrames);
+    for (size_t i = 0; i < inFrames; i++) {
+        for (uint32_t ch = 0; ch < channels; ch++) {
+            planar[ch * inFrames + i] = in[i * channels + ch];
+        }
+    }
+
+    for (size_t n = 0; n < count; n++) {
+        uint64_t pos = static_cast<uint64_t>(outStart + n) * inRate;
+        int64_t frame = pos / outRate;
+        int phase = static_cast<int>(((pos % outRate) * PHASES + outRate / 2) / outRate);
+
+        const float* taps = &coefficients[phase * TAPS];
+        int64_t start = frame - HALF_TAPS + 1 - inStart;
+
+        for (uint32_t ch = 0; ch < channels; ch++) {
+            const float* src = &planar[ch * inFrames];
+            float acc = 0;
+
+            if (start >= 0 && start + TAPS <= static_cast<int64_t>(inFrames)) {
+                // Independent lanes instead of one running sum, so this vectorizes without fast-math
+                float lanes[LANES] = {};
+                src += start;
+                for (int k = 0; k < TAPS; k += LANES) {
+                    for (int j = 0; j < LANES; j++) {
+                        lanes[j] += src[k + j] * taps[k + j];
+                    }
+                }
+                for (int j = 0; j < LANES; j++) {
+                    acc += lanes[j];
+                }
+            } else {
+                for (int k = 0; k < TAPS; k++) {
+                    int64_t i = start + k;
+                    if (i >= 0 && i < static_cast<int64_t>(inFrames)) {
+                        acc += src[i] * taps[k];
+                    }
+                }
+            }
+
+            out[n * channels + ch] = static_cast<int16_t>(std::clamp(std::lrint(acc), -32768L, 32767L));
+        }
+    }
+}
+
+} // namespace Decoder
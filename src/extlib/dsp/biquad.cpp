@@ -0,0 +1,96 @@
+#include <extlib/dsp/biquad.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace Dsp {
+
+constexpr float DEFAULT_Q = std::numbers::sqrt2_v<float> / 2;
+constexpr float DENORMAL_LIMIT = 1e-20f;
+
+void Biquad::configure(const AudioApiMasterEffect& params, uint32_t sampleRate) {
+    float fs = static_cast<float>(sampleRate);
+    float f0 = std::clamp(params.frequency, 10.0f, fs * 0.49f);
+    float q = params.q > 0 ? params.q : DEFAULT_Q;
+
+    float A = std::pow(10.0f, params.gainDb / 40);
+    float w0 = 2 * std::numbers::pi_v<float> * f0 / fs;
+    float cosw = std::cos(w0);
+    float alpha = std::sin(w0) / (2 * q);
+    float shelf = 2 * std::sqrt(A) * alpha;
+    float a0;
+
+    switch (type) {
+    case AUDIOAPI_MASTER_EQ_LOW_PASS:
+        b0 = (1 - cosw) / 2;
+        b1 = 1 - cosw;
+        b2 = (1 - cosw) / 2;
+        a0 = 1 + alpha;
+        a1 = -2 * cosw;
+        a2 = 1 - alpha;
+        break;
+    case AUDIOAPI_MASTER_EQ_HIGH_PASS:
+        b0 = (1 + cosw) / 2;
+        b1 = -(1 + cosw);
+        b2 = (1 + cosw) / 2;
+        a0 = 1 + alpha;
+        a1 = -2 * cosw;
+        a2 = 1 - alpha;
+        break;
+    case AUDIOAPI_MASTER_EQ_PEAK:
+        b0 = 1 + alpha * A;
+        b1 = -2 * cosw;
+        b2 = 1 - alpha * A;
+        a0 = 1 + alpha / A;
+        a1 = -2 * cosw;
+        a2 = 1 - alpha / A;
+        break;
+    case AUDIOAPI_MASTER_EQ_LOW_SHELF:
+        b0 = A * ((A + 1) - (A - 1) * cosw + shelf);
+        b1 = 2 * A * ((A - 1) - (A + 1) * cosw);
+        b2 = A * ((A + 1) - (A - 1) * cosw - shelf);
+        a0 = (A + 1) + (A - 1) * cosw + shelf;
+        a1 = -2 * ((A - 1) + (A + 1) * cosw);
+        a2 = (A + 1) + (A - 1) * cosw - shelf;
+        break;
+    case AUDIOAPI_MASTER_EQ_HIGH_SHELF:
+    default:
+        b0 = A * ((A + 1) + (A - 1) * cosw + shelf);
+        b1 = -2 * A * ((A - 1) + (A + 1) * cosw);
+        b2 = A * ((A + 1) + (A - 1) * cosw - shelf);
+        a0 = (A + 1) - (A - 1) * cosw + shelf;
+        a1 = 2 * ((A - 1) - (A + 1) * cosw);
+        a2 = (A + 1) - (A - 1) * cosw - shelf;
+        break;
+    }
+
+    b0 /= a0;
+    b1 /= a0;
+    b2 /= a0;
+    a1 /= a0;
+    a2 /= a0;
+}
+
+void Biquad::process(float* left, float* right, size_t frames) {
+    float* channels[2] = { left, right };
+
+    for (int ch = 0; ch < 2; ch++) {
+        float* data = channels[ch];
+        float s1 = z1[ch], s2 = z2[ch];
+
+        for (size_t i = 0; i < frames; i++) {
+            float x = data[i];
+            float y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            data[i] = y;
+        }
+
+        // Decaying tails would otherwise end up as slow denormals
+        z1[ch] = std::abs(s1) < DENORMAL_LIMIT ? 0 : s1;
+        z2[ch] = std::abs(s2) < DENORMAL_LIMIT ? 0 : s2;
+    }
+}
+
+} // namespace Dsp
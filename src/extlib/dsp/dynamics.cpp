@@ -0,0 +1,114 @@
+#include <extlib/dsp/dynamics.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Dsp {
+
+constexpr float DEFAULT_RATIO = 4.0f;
+constexpr float COMPRESSOR_ATTACK_MS = 10.0f;
+constexpr float COMPRESSOR_RELEASE_MS = 100.0f;
+constexpr float COMPRESSOR_KNEE_DB = 6.0f;
+constexpr float LIMITER_LOOKAHEAD_MS = 1.5f;
+constexpr float LIMITER_MAX_LOOKAHEAD_MS = 10.0f;
+constexpr float LIMITER_RELEASE_MS = 50.0f;
+constexpr float SILENCE_DB = -120.0f;
+
+static float timeCoef(float ms, uint32_t sampleRate) {
+    return std::exp(-1.0f / std::max(ms * 0.001f * sampleRate, 1.0f));
+}
+
+void Dynamics::configure(const AudioApiMasterEffect& params, uint32_t sampleRate) {
+    thresholdDb = params.thresholdDb;
+    threshold = std::pow(10.0f, thresholdDb / 20);
+
+    if (!limiter) {
+        float ratio = params.ratio >= 1 ? params.ratio : DEFAULT_RATIO;
+        slope = 1 - 1 / ratio;
+        makeup = std::pow(10.0f, params.gainDb / 20);
+        attackCoef = timeCoef(params.attackMs > 0 ? params.attackMs : COMPRESSOR_ATTACK_MS, sampleRate);
+        releaseCoef = timeCoef(params.releaseMs > 0 ? params.releaseMs : COMPRESSOR_RELEASE_MS, sampleRate);
+        return;
+    }
+
+    // The gain ramps down over the lookahead, reaching the needed reduction as the peak comes out
+    float lookaheadMs = std::min(params.attackMs > 0 ? params.attackMs : LIMITER_LOOKAHEAD_MS, LIMITER_MAX_LOOKAHEAD_MS);
+    size_t lookahead = std::max<size_t>(std::lround(lookaheadMs * 0.001f * sampleRate), 1);
+
+    attackCoef = std::exp(-4.0f / lookahead);
+    releaseCoef = timeCoef(params.releaseMs > 0 ? params.releaseMs : LIMITER_RELEASE_MS, sampleRate);
+
+    if (delay[0].size() != lookahead) {
+        delay[0].assign(lookahead, 0);
+        delay[1].assign(lookahead, 0);
+        delayPos = 0;
+        minGains.clear();
+    }
+}
+
+void Dynamics::process(float* left, float* right, size_t frames) {
+    if (limiter) {
+        limit(left, right, frames);
+    } else {
+        compress(left, right, frames);
+    }
+}
+
+// Gain reduction in dB follows the louder channel through a soft knee, both channels get the
+// same gain so the stereo image does not shift
+void Dynamics::compress(float* left, float* right, size_t frames) {
+    for (size_t i = 0; i < frames; i++) {
+        float peak = std::max(std::abs(left[i]), std::abs(right[i]));
+        float levelDb = peak > 0 ? 20 * std::log10(peak) : SILENCE_DB;
+        float overDb = levelDb - thresholdDb;
+
+        float targetDb = 0;
+        if (overDb >= COMPRESSOR_KNEE_DB / 2) {
+            targetDb = overDb * slope;
+        } else if (overDb > -COMPRESSOR_KNEE_DB / 2) {
+            float x = overDb + COMPRESSOR_KNEE_DB / 2;
+            targetDb = slope * x * x / (2 * COMPRESSOR_KNEE_DB);
+        }
+
+        float coef = targetDb > envelopeDb ? attackCoef : releaseCoef;
+        envelopeDb = targetDb + coef * (envelopeDb - targetDb);
+
+        float g = std::pow(10.0f, -envelopeDb / 20) * makeup;
+        left[i] *= g;
+        right[i] *= g;
+    }
+}
+
+void Dynamics::limit(float* left, float* right, size_t frames) {
+    size_t lookahead = delay[0].size();
+
+    for (size_t i = 0; i < frames; i++, sampleIndex++) {
+        float peak = std::max(std::abs(left[i]), std::abs(right[i]));
+        float need = peak > threshold ? threshold / peak : 1.0f;
+
+        // Running minimum over the samples still in the delay line
+        while (!minGains.empty() && minGains.back().second >= need) {
+            minGains.pop_back();
+        }
+        minGains.emplace_back(sampleIndex, need);
+        while (minGains.front().first + lookahead < sampleIndex) {
+            minGains.pop_front();
+        }
+
+        float target = minGains.front().second;
+        float coef = target < gain ? attackCoef : releaseCoef;
+        gain = target + coef * (gain - target);
+
+        float l = delay[0][delayPos];
+        float r = delay[1][delayPos];
+        delay[0][delayPos] = left[i];
+        delay[1][delayPos] = right[i];
+        delayPos = (delayPos + 1) % lookahead;
+
+        // The ramp can fall short on a sudden peak, the clamp catches what is left
+        left[i] = std::clamp(l * gain, -threshold, threshold);
+        right[i] = std::clamp(r * gain, -threshold, threshold);
+    }
+}
+
+} // namespace Dsp
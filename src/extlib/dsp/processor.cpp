@@ -0,0 +1,31 @@
+#include <extlib/dsp/processor.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include <extlib/dsp/biquad.hpp>
+#include <extlib/dsp/dynamics.hpp>
+#include <extlib/dsp/reverb.hpp>
+
+namespace Dsp {
+
+std::unique_ptr<Processor> factory(AudioApiMasterEffectType type) {
+    switch (type) {
+    case AUDIOAPI_MASTER_EQ_LOW_SHELF:
+    case AUDIOAPI_MASTER_EQ_PEAK:
+    case AUDIOAPI_MASTER_EQ_HIGH_SHELF:
+    case AUDIOAPI_MASTER_EQ_LOW_PASS:
+    case AUDIOAPI_MASTER_EQ_HIGH_PASS:
+        return std::make_unique<Biquad>(type);
+    case AUDIOAPI_MASTER_COMPRESSOR:
+        return std::make_unique<Dynamics>(false);
+    case AUDIOAPI_MASTER_LIMITER:
+        return std::make_unique<Dynamics>(true);
+    case AUDIOAPI_MASTER_REVERB:
+        return std::make_unique<Reverb>();
+    default:
+        throw std::invalid_argument("Invalid master effect type " + std::to_string(type));
+    }
+}
+
+} // namespace Dsp
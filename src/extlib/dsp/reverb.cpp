@@ -0,0 +1,99 @@
+#include <extlib/dsp/reverb.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Dsp {
+
+// Freeverb tunings at 44.1 kHz
+constexpr size_t COMB_TUNING[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+constexpr size_t ALLPASS_TUNING[] = { 556, 441, 341, 225 };
+constexpr size_t STEREO_SPREAD = 23;
+constexpr float TUNING_RATE = 44100.0f;
+
+constexpr float FIXED_GAIN = 0.015f;
+constexpr float SCALE_WET = 3.0f;
+constexpr float SCALE_DAMP = 0.4f;
+constexpr float SCALE_ROOM = 0.28f;
+constexpr float OFFSET_ROOM = 0.7f;
+constexpr float ALLPASS_FEEDBACK = 0.5f;
+
+void Reverb::configure(const AudioApiMasterEffect& params, uint32_t sampleRate) {
+    if (this->sampleRate != sampleRate) {
+        this->sampleRate = sampleRate;
+        float scale = sampleRate / TUNING_RATE;
+
+        for (size_t ch = 0; ch < 2; ch++) {
+            size_t spread = ch * STEREO_SPREAD;
+            for (size_t i = 0; i < NUM_COMBS; i++) {
+                combs[ch][i] = { std::vector<float>(std::lround((COMB_TUNING[i] + spread) * scale)), 0, 0 };
+            }
+            for (size_t i = 0; i < NUM_ALLPASSES; i++) {
+                allpasses[ch][i] = { std::vector<float>(std::lround((ALLPASS_TUNING[i] + spread) * scale)), 0 };
+            }
+        }
+    }
+
+    float mix = std::clamp(params.mix, 0.0f, 1.0f);
+    float width = std::clamp(params.width, 0.0f, 1.0f);
+    float wet = mix * SCALE_WET;
+
+    feedback = std::clamp(params.roomSize, 0.0f, 1.0f) * SCALE_ROOM + OFFSET_ROOM;
+    damp = std::clamp(params.damping, 0.0f, 1.0f) * SCALE_DAMP;
+    wet1 = wet * (width / 2 + 0.5f);
+    wet2 = wet * ((1 - width) / 2);
+    dry = 1 - mix;
+}
+
+// Each filter runs over the whole block at once, the delay lines stay in cache
+void Reverb::process(float* left, float* right, size_t frames) {
+    for (size_t ch = 0; ch < 2; ch++) {
+        auto& out = scratch[ch];
+        out.assign(frames, 0);
+
+        for (auto& comb : combs[ch]) {
+            float* buffer = comb.buffer.data();
+            size_t size = comb.buffer.size();
+            size_t pos = comb.pos;
+            float store = comb.store;
+
+            for (size_t i = 0; i < frames; i++) {
+                float input = (left[i] + right[i]) * FIXED_GAIN;
+                float y = buffer[pos];
+                store = y * (1 - damp) + store * damp;
+                buffer[pos] = input + store * feedback;
+                out[i] += y;
+                pos = pos + 1 == size ? 0 : pos + 1;
+            }
+
+            comb.pos = pos;
+            comb.store = std::abs(store) < 1e-20f ? 0 : store;
+        }
+
+        for (auto& allpass : allpasses[ch]) {
+            float* buffer = allpass.buffer.data();
+            size_t size = allpass.buffer.size();
+            size_t pos = allpass.pos;
+
+            for (size_t i = 0; i < frames; i++) {
+                float y = buffer[pos];
+                buffer[pos] = out[i] + y * ALLPASS_FEEDBACK;
+                out[i] = y - out[i];
+                pos = pos + 1 == size ? 0 : pos + 1;
+            }
+
+            allpass.pos = pos;
+        }
+    }
+
+    const float* wetLeft = scratch[0].data();
+    const float* wetRight = scratch[1].data();
+
+    for (size_t i = 0; i < frames; i++) {
+        float l = left[i], r = right[i];
+        left[i] = wetLeft[i] * wet1 + wetRight[i] * wet2 + l * dry;
+        right[i] = wetRight[i] * wet1 + wetLeft[i] * wet2 + r * dry;
+    }
+}
+
+} // namespace Dsp
@@ -0,0 +1,79 @@
+#include <extlib/handle_pool.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <extlib/resource/audiofile.hpp>
+
+// Audio files keep a file and a decoder open between decodes. Soundtrack packs register hundreds
+// of them, so only the most recently used stay open. Files busy decoding are skipped, the pool can
+// briefly go over the limit until they are done.
+
+struct PoolEntry {
+    Resource::Audiofile* owner;
+    uint64_t lastUse;
+};
+
+static std::vector<PoolEntry> sHandles;
+static size_t sHandleLimit = HANDLE_POOL_DEFAULT_LIMIT;
+static uint64_t sUseCounter = 0;
+static std::mutex sHandleMutex;
+
+static void trim() {
+    if (sHandles.size() <= sHandleLimit) {
+        return;
+    }
+
+    std::sort(sHandles.begin(), sHandles.end(), [](const auto& a, const auto& b) {
+        return a.lastUse < b.lastUse;
+    });
+
+    size_t excess = sHandles.size() - sHandleLimit;
+
+    // The most recently used entry is the one being opened, it is never closed here
+    std::erase_if(sHandles, [&excess](const auto& entry) {
+        if (excess == 0 || entry.lastUse == sUseCounter || !entry.owner->closeIdle()) {
+            return false;
+        }
+        excess--;
+        return true;
+    });
+}
+
+void handlePoolTouch(Resource::Audiofile* owner) {
+    std::lock_guard<std::mutex> lock(sHandleMutex);
+
+    auto it = std::find_if(sHandles.begin(), sHandles.end(), [owner](const auto& entry) {
+        return entry.owner == owner;
+    });
+
+    if (it != sHandles.end()) {
+        it->lastUse = ++sUseCounter;
+        return;
+    }
+
+    sHandles.push_back({ owner, ++sUseCounter });
+    trim();
+}
+
+void handlePoolRemove(Resource::Audiofile* owner) {
+    std::lock_guard<std::mutex> lock(sHandleMutex);
+
+    std::erase_if(sHandles, [owner](const auto& entry) {
+        return entry.owner == owner;
+    });
+}
+
+void handlePoolSetLimit(size_t limit) {
+    std::lock_guard<std::mutex> lock(sHandleMutex);
+
+    sHandleLimit = std::max<size_t>(limit, 1);
+    trim();
+}
+
+size_t handlePoolOpenCount() {
+    std::lock_guard<std::mutex> lock(sHandleMutex);
+    return sHandles.size();
+}
@@ -0,0 +1,305 @@
+#include <extlib/log.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include <plog/Init.h>
+#include <plog/Formatters/TxtFormatter.h>
+
+// Asynchronous logging. Threads that log, including the audio thread inside DMAs, only format the
+// record and push it into a fixed ring; a full ring drops the record instead of waiting. A background
+// thread drains the ring to the console and the log file, collapsing repeats of the same message.
+
+constexpr size_t LOG_RING_SLOTS = 1024;
+constexpr size_t LOG_LINE_MAX = 512;
+constexpr uint32_t LOG_RATE_LIMIT = 500;
+constexpr uint32_t LOG_REPEAT_LIMIT = 3;
+constexpr auto LOG_REPEAT_WINDOW = std::chrono::seconds(5);
+constexpr auto LOG_DRAIN_INTERVAL = std::chrono::milliseconds(10);
+constexpr size_t LOG_FILE_MAX_BYTES = 1024 * 1024;
+constexpr int LOG_FILE_COUNT = 3;
+
+static_assert((LOG_RING_SLOTS & (LOG_RING_SLOTS - 1)) == 0, "LOG_RING_SLOTS must be a power of two");
+
+struct LogSlot {
+    std::atomic<size_t> sequence;
+    plog::Severity severity;
+    size_t length;
+    size_t messageStart;
+    size_t messageHash;                     // Of the whole message, the text may be truncated
+    char text[LOG_LINE_MAX];
+};
+
+// Bounded multi-producer ring, single consumer. A slot is free for position pos when its
+// sequence is pos and holds a record when it is pos + 1.
+class LogRing {
+public:
+    LogRing() {
+        for (size_t i = 0; i < LOG_RING_SLOTS; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(plog::Severity severity, std::string_view line, size_t messageStart, size_t messageHash) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        LogSlot* slot;
+
+        while (true) {
+            slot = &slots[pos & (LOG_RING_SLOTS - 1)];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->severity = severity;
+        slot->length = std::min(line.size(), LOG_LINE_MAX);
+        slot->messageStart = std::min(messageStart, slot->length);
+        slot->messageHash = messageHash;
+        std::memcpy(slot->text, line.data(), slot->length);
+        if (line.size() > LOG_LINE_MAX) {
+            slot->text[LOG_LINE_MAX - 1] = '\n';
+        }
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template<class Func>
+    bool pop(Func&& func) {
+        auto& slot = slots[head & (LOG_RING_SLOTS - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+
+        std::string_view line(slot.text, slot.length);
+        func(slot.severity, line, line.substr(slot.messageStart), slot.messageHash);
+
+        slot.sequence.store(head + LOG_RING_SLOTS, std::memory_order_release);
+        head++;
+        return true;
+    }
+
+private:
+    std::array<LogSlot, LOG_RING_SLOTS> slots;
+    std::atomic<size_t> tail = 0;
+    size_t head = 0;
+};
+
+// Rotates to <name>.1<ext>, <name>.2<ext>... once the file reaches LOG_FILE_MAX_BYTES
+class RotatingFile {
+public:
+    void open(fs::path path) {
+        std::error_code ec;
+        fs::create_directories(path.parent_path(), ec);
+
+        this->path = path;
+        out.open(path, std::ios::binary | std::ios::app);
+        size = out ? static_cast<size_t>(out.tellp()) : 0;
+    }
+
+    void write(std::string_view text) {
+        if (!out.is_open()) {
+            return;
+        }
+
+        if (size + text.size() > LOG_FILE_MAX_BYTES) {
+            rotate();
+        }
+
+        out.write(text.data(), text.size());
+        size += text.size();
+    }
+
+    void flush() {
+        if (out.is_open()) {
+            out.flush();
+        }
+    }
+
+private:
+    fs::path rotated(int index) {
+        auto name = path.stem().string() + "." + std::to_string(index) + path.extension().string();
+        return path.parent_path() / name;
+    }
+
+    void rotate() {
+        std::error_code ec;
+
+        out.close();
+        fs::remove(rotated(LOG_FILE_COUNT - 1), ec);
+        for (int i = LOG_FILE_COUNT - 2; i >= 1; i--) {
+            fs::rename(rotated(i), rotated(i + 1), ec);
+        }
+        fs::rename(path, rotated(1), ec);
+
+        out.open(path, std::ios::binary | std::ios::trunc);
+        size = 0;
+    }
+
+    fs::path path;
+    std::ofstream out;
+    size_t size = 0;
+};
+
+struct Repeat {
+    std::chrono::steady_clock::time_point windowStart;
+    uint32_t count;
+    uint32_t suppressed;
+    plog::Severity severity;
+    std::string message;
+};
+
+static std::string narrow(const plog::util::nstring& str) {
+#if defined(_WIN32) && !defined(PLOG_CHAR_IS_UTF8)
+    return plog::util::toNarrow(str, plog::codePage::kUTF8);
+#else
+    return str;
+#endif
+}
+
+class AsyncAppender : public plog::IAppender {
+public:
+    void write(const plog::Record& record) override {
+        // Cheap global limit so a flood cannot push everything else out of the ring
+        auto second = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        auto window = rateWindow.load(std::memory_order_relaxed);
+        if (window != second && rateWindow.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+            rateCount.store(0, std::memory_order_relaxed);
+        }
+        if (rateCount.fetch_add(1, std::memory_order_relaxed) >= LOG_RATE_LIMIT) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto line = narrow(plog::TxtFormatter::format(record));
+        auto message = narrow(record.getMessage());
+
+        // The formatted line ends with the message and a newline. Repeats are matched on the whole
+        // message, a truncated line keeps as much of it as fits.
+        size_t messageStart = line.size() - std::min(line.size(), message.size() + 1);
+        size_t messageHash = std::hash<std::string>{}(message);
+        if (!ring.push(record.getSeverity(), line, messageStart, messageHash)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void run() {
+        auto lastSweep = std::chrono::steady_clock::now();
+
+        while (true) {
+            bool any = false;
+            while (ring.pop([this](plog::Severity severity, std::string_view line, std::string_view message, size_t hash) {
+                handle(severity, line, message, hash);
+            })) {
+                any = true;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastSweep > std::chrono::seconds(1)) {
+                sweep(now);
+                lastSweep = now;
+                any = true;
+            }
+
+            if (any) {
+                std::fflush(stdout);
+                file.flush();
+            }
+
+            std::this_thread::sleep_for(LOG_DRAIN_INTERVAL);
+        }
+    }
+
+    RotatingFile file;
+
+private:
+    void output(std::string_view text) {
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        file.write(text);
+    }
+
+    // Messages carry the resource or file they are about, so identical text means the same problem
+    void handle(plog::Severity severity, std::string_view line, std::string_view message, size_t hash) {
+        auto now = std::chrono::steady_clock::now();
+        auto [ it, inserted ] = repeats.try_emplace(hash, Repeat{ now, 0, 0, severity, std::string(message) });
+        auto& repeat = it->second;
+
+        if (now - repeat.windowStart > LOG_REPEAT_WINDOW) {
+            summarize(repeat);
+            repeat = { now, 0, 0, severity, std::string(message) };
+        }
+
+        if (++repeat.count > LOG_REPEAT_LIMIT) {
+            repeat.suppressed++;
+            return;
+        }
+
+        output(line);
+    }
+
+    void summarize(const Repeat& repeat) {
+        if (repeat.suppressed == 0) {
+            return;
+        }
+
+        output(std::string(plog::severityToString(repeat.severity)) + " Last message repeated " +
+               std::to_string(repeat.suppressed) + " more times: " + repeat.message);
+    }
+
+    void sweep(std::chrono::steady_clock::time_point now) {
+        for (auto it = repeats.begin(); it != repeats.end();) {
+            if (now - it->second.windowStart > LOG_REPEAT_WINDOW) {
+                summarize(it->second);
+                it = repeats.erase(it);
+            } else {
+                it++;
+            }
+        }
+
+        if (auto count = dropped.exchange(0)) {
+            output("WARN " + std::to_string(count) + " log messages dropped\n");
+        }
+    }
+
+    LogRing ring;
+    std::atomic<int64_t> rateWindow = 0;
+    std::atomic<uint32_t> rateCount = 0;
+    std::atomic<size_t> dropped = 0;
+
+    // Consumer thread only, keyed by message hash
+    std::unordered_map<size_t, Repeat> repeats;
+};
+
+static AsyncAppender sAsyncAppender;
+
+void logInit(plog::Severity severity, fs::path logFile) {
+    if (!logFile.empty()) {
+        sAsyncAppender.file.open(logFile);
+    }
+
+    plog::init(severity, &sAsyncAppender);
+
+    std::thread([]() {
+        sAsyncAppender.run();
+    }).detach();
+}
@@ -1,23 +1,36 @@
 #include <extlib/main.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include <plog/Log.h>
-#include <plog/Init.h>
-#include <plog/Formatters/TxtFormatter.h>
-#include <plog/Initializers/ConsoleInitializer.h>
 
 #include <audio_api/types.h>
 
+#include <extlib/handle_pool.hpp>
 #include <extlib/lib_recomp.hpp>
+#include <extlib/log.hpp>
+#include <extlib/master_bus.hpp>
+#include <extlib/profile.hpp>
 #include <extlib/resource/abstract.hpp>
 #include <extlib/resource/audiofile.hpp>
 #include <extlib/resource/generic.hpp>
 #include <extlib/resource/samplebank.hpp>
+#include <extlib/silence.hpp>
+#include <extlib/stats.hpp>
 #include <extlib/thread.hpp>
+#include <extlib/trace.hpp>
+#include <extlib/vfs/zip_archive.hpp>
+#include <extlib/vfs/zip_entry_cache.hpp>
 
 extern "C" {
     DLLEXPORT uint32_t recomp_api_version = RECOMP_API_VERSION;
@@ -28,25 +41,93 @@ namespace fs = std::filesystem;
 static bool sIsInitialized = false;
 static size_t sResourceCount = 0;
 
+// Sample rate audio files whose options set no targetSampleRate are resampled to, 0 keeps their rate
+static std::atomic<uint32_t> sResampleRate = 0;
+
 Vfs::Filesystem gVfs;
 std::unordered_map<size_t, std::shared_ptr<Resource::Abstract>> gResourceData;
 std::shared_mutex gResourceDataMutex;
 
-static plog::ConsoleAppender<plog::TxtFormatter> sConsoleAppender;
+// Group id -> resource ids, so mods can prefetch, pin and release related resources together
+static std::unordered_map<size_t, std::unordered_set<size_t>> sResourceGroups;
+static std::mutex sResourceGroupsMutex;
+static size_t sResourceGroupCount = 0;
+
+static std::shared_ptr<Resource::Abstract> getResource(size_t resourceId) {
+    std::shared_lock<std::shared_mutex> lock(gResourceDataMutex);
+
+    auto it = gResourceData.find(resourceId);
+    if (it == gResourceData.end()) {
+        throw std::invalid_argument("Invalid resourceId " + std::to_string(resourceId));
+    }
+
+    return it->second;
+}
+
+// Identifies a file across sessions for the session profile and silence maps. The modification
+// time tells apart a file replaced by another of the same size.
+static std::string profileKeyOf(Vfs::File& file) {
+    return std::to_string(file.size()) + ":" + std::to_string(file.modifiedTime()) + ":" + file.fullpath();
+}
+
+// Stats bucket the DMAs of a resource are counted in
+static AudioApiStatsType getStatsType(const std::shared_ptr<Resource::Abstract>& resource) {
+    if (dynamic_cast<Resource::Audiofile*>(resource.get())) {
+        return AUDIOAPI_STATS_AUDIO_FILE;
+    }
+    if (dynamic_cast<Resource::SampleBank*>(resource.get())) {
+        return AUDIOAPI_STATS_SAMPLE_BANK;
+    }
+    return AUDIOAPI_STATS_RESOURCE;
+}
+
+// Options the mod's header does not know about yet keep their zero defaults
+static AudioApiFileOptions readFileOptions(const AudioApiFileOptions* options) {
+    AudioApiFileOptions result = {};
+    std::memcpy(&result, options, std::min<size_t>(options->size, sizeof(result)));
+    result.size = sizeof(result);
+    return result;
+}
+
+// Resources removed since they were added to the group are skipped
+static std::vector<std::shared_ptr<Resource::Abstract>> getResourceGroup(size_t groupId) {
+    std::vector<std::shared_ptr<Resource::Abstract>> resources;
+
+    std::lock_guard<std::mutex> groupLock(sResourceGroupsMutex);
+    std::shared_lock<std::shared_mutex> resourceLock(gResourceDataMutex);
+
+    auto group = sResourceGroups.find(groupId);
+    if (group == sResourceGroups.end()) {
+        throw std::invalid_argument("Invalid groupId " + std::to_string(groupId));
+    }
+
+    for (auto resourceId : group->second) {
+        auto it = gResourceData.find(resourceId);
+        if (it != gResourceData.end()) {
+            resources.push_back(it->second);
+        }
+    }
+
+    return resources;
+}
 
 RECOMP_DLL_FUNC(AudioApiNative_Init) {
     auto logLevel = RECOMP_ARG(uint32_t, 0);
     auto rootDirStr = RECOMP_ARG_U8STR(1);
+    auto logToFile = RECOMP_ARG(uint32_t, 2);
 
     try {
         if (sIsInitialized) {
             throw std::runtime_error("Extlib already initialized");
         }
 
-        plog::init((plog::Severity)logLevel, &sConsoleAppender);
+        logInit((plog::Severity)logLevel, logToFile
+            ? fs::path(rootDirStr).parent_path() / "mod_data" / "audio_api.log"
+            : fs::path());
+
+        auto rootDir = fs::canonical(fs::path(rootDirStr).parent_path());
 
         {
-            auto rootDir = fs::canonical(fs::path(rootDirStr).parent_path());
             auto defaultDir = rootDir / "mod_data" / "audio";
             PLOG_INFO << "Root Dir: " << rootDir;
             PLOG_INFO << "Default Dir: " << defaultDir;
@@ -60,6 +141,13 @@ RECOMP_DLL_FUNC(AudioApiNative_Init) {
             gVfs.addKnownZipExtension(".mmrs");
         }
 
+        profileLoad(rootDir / "mod_data" / "audio_api.profile");
+
+        // The worker only saves every minute, this keeps short sessions and the last minute
+        std::atexit(profileSave);
+        silenceLoad(rootDir / "mod_data" / "audio_api.silence");
+        traceSetOutputDir(rootDir / "mod_data");
+
         {
             std::thread workerThread(workerThreadLoop);
             workerThread.detach();
@@ -81,7 +169,9 @@ RECOMP_DLL_FUNC(AudioApiNative_Init) {
     RECOMP_RETURN(bool, false);
 }
 
+// Every mod has registered its resources by now
 RECOMP_DLL_FUNC(AudioApiNative_Ready) {
+    profileWarmStart();
     RECOMP_RETURN(bool, true);
 }
 
@@ -98,22 +188,23 @@ RECOMP_DLL_FUNC(AudioApiNative_Dma) {
     auto args = TO_PTR(uint32_t, RECOMP_ARG(int32_t, 3));
     size_t resourceId = args[0];
 
-    try {
-        std::shared_ptr<Resource::Abstract> resource;
-        {
-            std::shared_lock<std::shared_mutex> lock(gResourceDataMutex);
+    TraceScope trace("AudioApiNative_Dma", "dma", "resourceId", resourceId);
 
-            auto it = gResourceData.find(resourceId);
-            if (it == gResourceData.end()) {
-                throw std::invalid_argument("Invalid resourceId " + std::to_string(resourceId));
-            }
+    auto start = std::chrono::steady_clock::now();
+    auto statsType = AUDIOAPI_STATS_ALL;
+    statsBeginDma();
 
-            resource = std::static_pointer_cast<Resource::Abstract>(it->second);
-        }
+    try {
+        auto resource = getResource(resourceId);
+        statsType = getStatsType(resource);
 
         resource->dma(rdram, ptr, offset, size, args[1], args[2]);
         queuePreload(resourceId);
 
+        // Audio files are DMAed in samples of one track
+        size_t bytes = statsType == AUDIOAPI_STATS_AUDIO_FILE ? size * sizeof(int16_t) : size;
+        statsEndDma(statsType, (std::chrono::steady_clock::now() - start) / std::chrono::nanoseconds(1), bytes, true);
+
         RECOMP_RETURN(bool, true);
 
     } catch (const fs::filesystem_error& e) {
@@ -126,6 +217,7 @@ RECOMP_DLL_FUNC(AudioApiNative_Dma) {
         PLOG_ERROR << "DMA Error: Unknown error";
     }
 
+    statsEndDma(statsType, (std::chrono::steady_clock::now() - start) / std::chrono::nanoseconds(1), 0, false);
     RECOMP_RETURN(bool, false);
 }
 
@@ -139,6 +231,7 @@ RECOMP_DLL_FUNC(AudioApiNative_AddResource) {
         // TODO: if info->filesize exists, avoid opening file and just check that it exists
         auto file = gVfs.openFile(baseDir, path);
         auto resource = std::make_shared<Resource::Generic>(file, cacheStrategy);
+        resource->profileKey = profileKeyOf(*file);
 
         info->resourceId = sResourceCount++;
         info->cacheStrategy = static_cast<AudioApiCacheStrategy>(cacheStrategy);
@@ -171,12 +264,14 @@ RECOMP_DLL_FUNC(AudioApiNative_AddAudioFile) {
     auto info = RECOMP_ARG(AudioApiFileInfo*, 0);
     auto baseDir = RECOMP_ARG_U8STR(1);
     auto path = RECOMP_ARG_U8STR(2);
+    auto options = readFileOptions(RECOMP_ARG(AudioApiFileOptions*, 3));
     auto codec = Decoder::parseType(info->codec);
     auto cacheStrategy = Resource::parseCacheStrategy(info->cacheStrategy);
 
     try {
         auto file = gVfs.openFile(baseDir, path);
         auto resource = std::make_shared<Resource::Audiofile>(file, codec, cacheStrategy);
+        resource->profileKey = profileKeyOf(*file);
 
         if (info->trackCount && info->sampleCount) {
             resource->metadata->setTrackCount(info->trackCount);
@@ -190,6 +285,10 @@ RECOMP_DLL_FUNC(AudioApiNative_AddAudioFile) {
             resource->close();
         }
 
+        resource->setChannelMix(options.channelMix, options.channelMap, options.mixTrackCount);
+        resource->setTargetSampleRate(options.targetSampleRate ? options.targetSampleRate : sResampleRate.load());
+        resource->setSilenceMode(options.silenceMode);
+
         info->resourceId  = sResourceCount++;
         info->trackCount  = resource->metadata->trackCount;
         info->sampleRate  = resource->metadata->sampleRate;
@@ -237,6 +336,7 @@ RECOMP_DLL_FUNC(AudioApiNative_AddSampleBank) {
         // TODO: if info->filesize exists, avoid opening file and just check that it exists
         auto file = gVfs.openFile(baseDir, path);
         auto resource = std::make_shared<Resource::SampleBank>(file, cacheStrategy);
+        resource->profileKey = profileKeyOf(*file);
 
         info->resourceId = sResourceCount++;
         info->cacheStrategy = static_cast<AudioApiCacheStrategy>(cacheStrategy);
@@ -264,3 +364,396 @@ RECOMP_DLL_FUNC(AudioApiNative_AddSampleBank) {
 
     RECOMP_RETURN(bool, false);
 }
+
+RECOMP_DLL_FUNC(AudioApiNative_RemoveResource) {
+    size_t resourceId = RECOMP_ARG(uint32_t, 0);
+
+    std::shared_ptr<Resource::Abstract> resource;
+    {
+        std::unique_lock<std::shared_mutex> lock(gResourceDataMutex);
+
+        auto it = gResourceData.find(resourceId);
+        if (it == gResourceData.end()) {
+            PLOG_ERROR << "Error removing resource: Invalid resourceId " << resourceId;
+            RECOMP_RETURN(bool, false);
+        }
+
+        resource = std::move(it->second);
+        gResourceData.erase(it);
+    }
+
+    // Caches and file handles are released with the last reference, which may be a running preload task
+    PLOG_DEBUG << "Removed resource " << resourceId;
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_PreloadResource) {
+    size_t resourceId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        getResource(resourceId)->requestPreload();
+        queuePreload(resourceId);
+        workerThreadNotify();
+
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error preloading resource: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_PinResource) {
+    size_t resourceId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        getResource(resourceId)->pin();
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error pinning resource: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_UnpinResource) {
+    size_t resourceId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        getResource(resourceId)->unpin();
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error unpinning resource: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_EvictResource) {
+    size_t resourceId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        getResource(resourceId)->requestEvict();
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error evicting resource: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_CreateResourceGroup) {
+    std::lock_guard<std::mutex> lock(sResourceGroupsMutex);
+
+    size_t groupId = sResourceGroupCount++;
+    sResourceGroups[groupId] = {};
+
+    RECOMP_RETURN(uint32_t, groupId);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_AddToResourceGroup) {
+    size_t groupId = RECOMP_ARG(uint32_t, 0);
+    size_t resourceId = RECOMP_ARG(uint32_t, 1);
+
+    try {
+        getResource(resourceId);
+
+        std::lock_guard<std::mutex> lock(sResourceGroupsMutex);
+
+        auto group = sResourceGroups.find(groupId);
+        if (group == sResourceGroups.end()) {
+            throw std::invalid_argument("Invalid groupId " + std::to_string(groupId));
+        }
+
+        group->second.insert(resourceId);
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error adding to resource group: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_PrefetchResourceGroup) {
+    size_t groupId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        std::lock_guard<std::mutex> lock(sResourceGroupsMutex);
+
+        auto group = sResourceGroups.find(groupId);
+        if (group == sResourceGroups.end()) {
+            throw std::invalid_argument("Invalid groupId " + std::to_string(groupId));
+        }
+
+        std::shared_lock<std::shared_mutex> resourceLock(gResourceDataMutex);
+
+        for (auto resourceId : group->second) {
+            auto it = gResourceData.find(resourceId);
+            if (it != gResourceData.end()) {
+                it->second->requestPreload();
+                queuePreload(resourceId);
+            }
+        }
+
+        workerThreadNotify();
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error prefetching resource group: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_IsResourceGroupReady) {
+    size_t groupId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        for (const auto& resource : getResourceGroup(groupId)) {
+            if (!resource->isPreloaded()) {
+                RECOMP_RETURN(bool, false);
+            }
+        }
+
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error checking resource group: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_PinResourceGroup) {
+    size_t groupId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        for (const auto& resource : getResourceGroup(groupId)) {
+            resource->pin();
+        }
+
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error pinning resource group: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_UnpinResourceGroup) {
+    size_t groupId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        for (const auto& resource : getResourceGroup(groupId)) {
+            resource->unpin();
+        }
+
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error unpinning resource group: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+// Unpins and evicts every resource in the group, the group itself stays usable
+RECOMP_DLL_FUNC(AudioApiNative_ReleaseResourceGroup) {
+    size_t groupId = RECOMP_ARG(uint32_t, 0);
+
+    try {
+        for (const auto& resource : getResourceGroup(groupId)) {
+            resource->unpin();
+            resource->requestEvict();
+        }
+
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error releasing resource group: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_SetWarmStartBudget) {
+    size_t budget = RECOMP_ARG(uint32_t, 0);
+
+    profileSetWarmBudget(budget);
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_SetResampleRate) {
+    sResampleRate = RECOMP_ARG(uint32_t, 0);
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_SetOpenFileLimit) {
+    size_t limit = RECOMP_ARG(uint32_t, 0);
+
+    handlePoolSetLimit(limit);
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_SetTracing) {
+    auto enabled = RECOMP_ARG(uint32_t, 0);
+
+    traceEnable(enabled != 0);
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_DumpTrace) {
+    try {
+        auto path = traceDump();
+        PLOG_INFO << "Trace written to " << path;
+        RECOMP_RETURN(bool, true);
+
+    } catch (const std::runtime_error& e) {
+        PLOG_ERROR << "Trace dump error: " << e.what();
+    } catch (...) {
+        PLOG_ERROR << "Trace dump error: Unknown error";
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_GetStreamingStats) {
+    auto stats = RECOMP_ARG(AudioApiStreamingStats*, 0);
+    auto type = RECOMP_ARG(uint32_t, 1);
+
+    if (type >= AUDIOAPI_STATS_MAX) {
+        PLOG_ERROR << "Invalid stats type " << type;
+        RECOMP_RETURN(bool, false);
+    }
+
+    statsGet(static_cast<AudioApiStatsType>(type), stats);
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_ResetStreamingStats) {
+    statsReset();
+    RECOMP_RETURN(bool, true);
+}
+
+static uint32_t clamp32(size_t value) {
+    return static_cast<uint32_t>(std::min<size_t>(value, UINT32_MAX));
+}
+
+// Fills up to maxEntries entries and returns the number of resources, which may be more
+RECOMP_DLL_FUNC(AudioApiNative_GetResourceMemory) {
+    auto entries = RECOMP_ARG(AudioApiResourceMemory*, 0);
+    size_t maxEntries = RECOMP_ARG(uint32_t, 1);
+    auto sort = RECOMP_ARG(uint32_t, 2);
+
+    std::vector<std::pair<size_t, std::shared_ptr<Resource::Abstract>>> resources;
+    {
+        std::shared_lock<std::shared_mutex> lock(gResourceDataMutex);
+        resources.assign(gResourceData.begin(), gResourceData.end());
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<AudioApiResourceMemory> result;
+    result.reserve(resources.size());
+
+    for (const auto& [ resourceId, resource ] : resources) {
+        auto info = resource->getMemoryInfo();
+        auto lastUse = resource->lastUse();
+
+        result.push_back({
+            .resourceId = clamp32(resourceId),
+            .cachedBytes = clamp32(info.cachedBytes),
+            .entries = clamp32(info.entries),
+            .fileBytes = clamp32(info.fileBytes),
+            .mappedBytes = clamp32(info.mappedBytes),
+            .idleMs = lastUse == EPOCH ? UINT32_MAX
+                : clamp32(std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUse).count()),
+        });
+    }
+
+    std::sort(result.begin(), result.end(), [sort](const auto& a, const auto& b) {
+        if (sort == AUDIOAPI_MEMORY_SORT_SIZE) {
+            return static_cast<uint64_t>(a.cachedBytes) + a.fileBytes > static_cast<uint64_t>(b.cachedBytes) + b.fileBytes;
+        }
+        return a.resourceId < b.resourceId;
+    });
+
+    std::copy_n(result.begin(), std::min(maxEntries, result.size()), entries);
+
+    RECOMP_RETURN(uint32_t, result.size());
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_GetMemoryTotal) {
+    auto total = RECOMP_ARG(AudioApiMemoryTotal*, 0);
+    Resource::MemoryInfo sum;
+    size_t count;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(gResourceDataMutex);
+        count = gResourceData.size();
+
+        for (const auto& [ resourceId, resource ] : gResourceData) {
+            auto info = resource->getMemoryInfo();
+            sum.cachedBytes += info.cachedBytes;
+            sum.entries += info.entries;
+            sum.fileBytes += info.fileBytes;
+            sum.mappedBytes += info.mappedBytes;
+        }
+    }
+
+    total->resourceCount = clamp32(count);
+    total->cachedBytes = clamp32(sum.cachedBytes);
+    total->entries = clamp32(sum.entries);
+    total->fileBytes = clamp32(sum.fileBytes);
+    total->mappedBytes = clamp32(sum.mappedBytes);
+    total->archiveBytes = clamp32(Vfs::ZipArchive::totalResidentBytes());
+    total->zipEntryBytes = clamp32(Vfs::ZipEntryCache::totalBytes());
+
+    RECOMP_RETURN(bool, true);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_AddMasterEffect) {
+    auto effect = RECOMP_ARG(AudioApiMasterEffect*, 0);
+
+    try {
+        auto id = masterBusAdd(*effect);
+        RECOMP_RETURN(int32_t, id);
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error adding master effect: " << e.what();
+    }
+
+    RECOMP_RETURN(int32_t, -1);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_UpdateMasterEffect) {
+    auto id = RECOMP_ARG(int32_t, 0);
+    auto effect = RECOMP_ARG(AudioApiMasterEffect*, 1);
+
+    try {
+        RECOMP_RETURN(bool, masterBusUpdate(id, *effect));
+    } catch (const std::invalid_argument& e) {
+        PLOG_ERROR << "Error updating master effect: " << e.what();
+    }
+
+    RECOMP_RETURN(bool, false);
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_RemoveMasterEffect) {
+    auto id = RECOMP_ARG(int32_t, 0);
+
+    RECOMP_RETURN(bool, masterBusRemove(id));
+}
+
+RECOMP_DLL_FUNC(AudioApiNative_ProcessMasterBus) {
+    auto ptr = RECOMP_ARG(int32_t, 0);
+    size_t frames = RECOMP_ARG(uint32_t, 1);
+    auto sampleRate = RECOMP_ARG(uint32_t, 2);
+
+    masterBusProcess(rdram, ptr, frames, sampleRate);
+    RECOMP_RETURN(bool, true);
+}
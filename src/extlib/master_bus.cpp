@@ -0,0 +1,113 @@
+#include <extlib/master_bus.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <extlib/dsp/processor.hpp>
+#include <extlib/rdram.hpp>
+#include <extlib/trace.hpp>
+
+// Master bus: DSP processors added by mods, run over each AI buffer after the RSP has mixed it and
+// right before it is handed to the audio interface. Samples are processed as planar floats so the
+// format conversions vectorize, and only converted back to 16-bit once at the end of the chain.
+
+constexpr float SAMPLE_SCALE = 32768.0f;
+
+struct MasterEffect {
+    int32_t id;
+    AudioApiMasterEffect params;
+    std::unique_ptr<Dsp::Processor> processor;
+};
+
+static std::vector<MasterEffect> sEffects;
+static std::mutex sMasterBusMutex;
+static int32_t sNextEffectId = 0;
+static uint32_t sSampleRate = 0;
+
+static std::vector<int16_t> sPcm;
+static std::vector<float> sLeft;
+static std::vector<float> sRight;
+
+int32_t masterBusAdd(const AudioApiMasterEffect& effect) {
+    auto processor = Dsp::factory(effect.type);
+
+    std::lock_guard<std::mutex> lock(sMasterBusMutex);
+
+    if (sSampleRate != 0) {
+        processor->configure(effect, sSampleRate);
+    }
+
+    int32_t id = sNextEffectId++;
+    sEffects.push_back({ id, effect, std::move(processor) });
+
+    return id;
+}
+
+// Parameter changes keep the processor and its state, so reverb tails and envelopes carry over
+bool masterBusUpdate(int32_t id, const AudioApiMasterEffect& effect) {
+    std::lock_guard<std::mutex> lock(sMasterBusMutex);
+
+    auto it = std::find_if(sEffects.begin(), sEffects.end(), [id](const auto& e) { return e.id == id; });
+    if (it == sEffects.end()) {
+        return false;
+    }
+
+    if (it->params.type != effect.type) {
+        it->processor = Dsp::factory(effect.type);
+    }
+    it->params = effect;
+
+    if (sSampleRate != 0) {
+        it->processor->configure(effect, sSampleRate);
+    }
+
+    return true;
+}
+
+bool masterBusRemove(int32_t id) {
+    std::lock_guard<std::mutex> lock(sMasterBusMutex);
+
+    return std::erase_if(sEffects, [id](const auto& e) { return e.id == id; }) > 0;
+}
+
+void masterBusProcess(uint8_t* rdram, int32_t ptr, size_t frames, uint32_t sampleRate) {
+    TraceScope trace("masterBus", "dsp", "frames", frames);
+
+    std::lock_guard<std::mutex> lock(sMasterBusMutex);
+
+    if (sEffects.empty() || frames == 0 || sampleRate == 0) {
+        return;
+    }
+
+    if (sampleRate != sSampleRate) {
+        sSampleRate = sampleRate;
+        for (auto& effect : sEffects) {
+            effect.processor->configure(effect.params, sSampleRate);
+        }
+    }
+
+    sPcm.resize(frames * 2);
+    sLeft.resize(frames);
+    sRight.resize(frames);
+
+    copy_halfwords_from_rdram(rdram, ptr, sPcm.data(), frames * 2);
+
+    for (size_t i = 0; i < frames; i++) {
+        sLeft[i] = sPcm[i * 2] * (1 / SAMPLE_SCALE);
+        sRight[i] = sPcm[i * 2 + 1] * (1 / SAMPLE_SCALE);
+    }
+
+    for (auto& effect : sEffects) {
+        effect.processor->process(sLeft.data(), sRight.data(), frames);
+    }
+
+    for (size_t i = 0; i < frames; i++) {
+        sPcm[i * 2] = static_cast<int16_t>(std::clamp(sLeft[i] * SAMPLE_SCALE, -SAMPLE_SCALE, SAMPLE_SCALE - 1));
+        sPcm[i * 2 + 1] = static_cast<int16_t>(std::clamp(sRight[i] * SAMPLE_SCALE, -SAMPLE_SCALE, SAMPLE_SCALE - 1));
+    }
+
+    copy_halfwords_to_rdram(rdram, ptr, sPcm.data(), frames * 2);
+}
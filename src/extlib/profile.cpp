@@ -0,0 +1,199 @@
+#include <extlib/profile.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <plog/Log.h>
+
+#include <extlib/main.hpp>
+#include <extlib/resource/abstract.hpp>
+#include <extlib/trace.hpp>
+
+// Session profile: which ranges of which resources were used, so the next launch can preload them
+// before they are first played. Scores of earlier sessions decay by half every launch.
+
+constexpr const char* PROFILE_MAGIC = "AUDIOAPI_PROFILE 1";
+constexpr size_t PROFILE_MAX_ENTRIES = 4096;
+constexpr double PROFILE_DECAY = 0.5;
+constexpr size_t PROFILE_DEFAULT_WARM_BUDGET = 32 * 1024 * 1024;
+constexpr unsigned PROFILE_WARM_THREADS = 2;
+
+struct ProfileEntry {
+    std::string key;
+    size_t range;
+    double score;
+};
+
+static fs::path sProfilePath;
+static std::unordered_map<std::string, std::unordered_map<size_t, double>> sProfile;
+static std::mutex sProfileMutex;
+static std::atomic<size_t> sWarmBudget = PROFILE_DEFAULT_WARM_BUDGET;
+
+static std::vector<ProfileEntry> sortedEntries() {
+    std::vector<ProfileEntry> entries;
+
+    for (const auto& [ key, ranges ] : sProfile) {
+        for (const auto& [ range, score ] : ranges) {
+            entries.push_back({ key, range, score });
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.score > b.score;
+    });
+
+    return entries;
+}
+
+// Format: magic line, then one "<score> <range> <key>" line per entry. Keys may contain spaces.
+void profileLoad(fs::path path) {
+    std::lock_guard<std::mutex> lock(sProfileMutex);
+
+    sProfilePath = path;
+
+    std::ifstream stream(path);
+    if (!stream.is_open()) {
+        return;
+    }
+
+    std::string line;
+    if (!std::getline(stream, line) || line != PROFILE_MAGIC) {
+        PLOG_ERROR << "Ignoring invalid session profile: " << path;
+        return;
+    }
+
+    double score;
+    size_t range;
+    while (stream >> score >> range && std::getline(stream >> std::ws, line)) {
+        sProfile[line][range] = score * PROFILE_DECAY;
+    }
+
+    PLOG_DEBUG << "Loaded session profile for " << sProfile.size() << " resources";
+}
+
+void profileSave() {
+    std::vector<std::pair<std::string, std::map<size_t, uint32_t>>> used;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(gResourceDataMutex);
+
+        for (const auto& [ resourceId, resource ] : gResourceData) {
+            auto ranges = resource->takeUsedRanges();
+            if (!ranges.empty() && !resource->profileKey.empty()) {
+                used.emplace_back(resource->profileKey, std::move(ranges));
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(sProfileMutex);
+
+    if (sProfilePath.empty() || used.empty()) {
+        return;
+    }
+
+    for (const auto& [ key, ranges ] : used) {
+        for (const auto& [ range, hits ] : ranges) {
+            sProfile[key][range] += hits;
+        }
+    }
+
+    auto entries = sortedEntries();
+    if (entries.size() > PROFILE_MAX_ENTRIES) {
+        entries.resize(PROFILE_MAX_ENTRIES);
+    }
+
+    // Written next to the profile and renamed, so a crash never leaves a truncated profile
+    auto tmpPath = sProfilePath;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream stream(tmpPath, std::ios::trunc);
+        if (!stream.is_open()) {
+            PLOG_ERROR << "Could not write session profile: " << tmpPath;
+            return;
+        }
+
+        stream << PROFILE_MAGIC << "\n";
+        for (const auto& entry : entries) {
+            stream << entry.score << " " << entry.range << " " << entry.key << "\n";
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, sProfilePath, ec);
+    if (ec) {
+        PLOG_ERROR << "Could not write session profile: " << ec.message();
+    }
+}
+
+void profileSetWarmBudget(size_t bytes) {
+    sWarmBudget.store(bytes);
+}
+
+// Preloads the highest scoring ranges of registered resources on background threads, each range
+// counts as PROFILE_RANGE_SIZE bytes against the budget
+void profileWarmStart() {
+    std::vector<std::pair<Resource::ResourcePtr, size_t>> work;
+
+    {
+        std::lock_guard<std::mutex> profileLock(sProfileMutex);
+        std::shared_lock<std::shared_mutex> resourceLock(gResourceDataMutex);
+
+        std::unordered_map<std::string, Resource::ResourcePtr> resources;
+        for (const auto& [ resourceId, resource ] : gResourceData) {
+            resources[resource->profileKey] = resource;
+        }
+
+        size_t budget = sWarmBudget.load();
+        for (const auto& entry : sortedEntries()) {
+            if (budget < Resource::PROFILE_RANGE_SIZE) {
+                break;
+            }
+
+            auto it = resources.find(entry.key);
+            if (it == resources.end()) {
+                continue;
+            }
+
+            work.emplace_back(it->second, entry.range);
+            budget -= Resource::PROFILE_RANGE_SIZE;
+        }
+    }
+
+    if (work.empty()) {
+        return;
+    }
+
+    PLOG_DEBUG << "Warm starting " << work.size() << " profiled ranges";
+
+    auto shared = std::make_shared<decltype(work)>(std::move(work));
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+
+    for (unsigned i = 0; i < PROFILE_WARM_THREADS; i++) {
+        std::thread([shared, next]() {
+            traceSetThreadName("warm start");
+
+            for (size_t n = (*next)++; n < shared->size(); n = (*next)++) {
+                auto& [ resource, range ] = (*shared)[n];
+                TraceScope trace("preloadRange", "preload", "range", range);
+
+                try {
+                    resource->markWarm();
+                    resource->preloadRange(range);
+                } catch (const std::runtime_error& e) {
+                    PLOG_ERROR << "Error warm starting resource: " << e.what();
+                } catch (...) {
+                    PLOG_ERROR << "Error warm starting resource: Unknown error";
+                }
+            }
+        }).detach();
+    }
+}
@@ -0,0 +1,97 @@
+#include <extlib/rdram.hpp>
+
+#include <bit>
+#include <cstring>
+
+static inline uint8_t* rdram_addr(uint8_t* rdram, uint64_t vaddr) {
+    return rdram + vaddr - 0xFFFFFFFF80000000;
+}
+
+void copy_to_rdram(uint8_t* rdram, int32_t ptr, const uint8_t* src, size_t size) {
+    uint64_t vaddr = static_cast<uint64_t>(static_cast<int64_t>(ptr));
+    size_t i = 0;
+
+    for (; i < size && (vaddr + i) % 4 != 0; i++) {
+        *rdram_addr(rdram, (vaddr + i) ^ 3) = src[i];
+    }
+
+    // Each big-endian source word is stored as one host word, a plain byteswap the compiler vectorizes
+    uint8_t* dst = rdram_addr(rdram, vaddr + i);
+    size_t words = (size - i) / 4;
+
+    for (size_t w = 0; w < words; w++) {
+        uint32_t word;
+        std::memcpy(&word, src + i + w * 4, sizeof(word));
+        word = std::byteswap(word);
+        std::memcpy(dst + w * 4, &word, sizeof(word));
+    }
+    i += words * 4;
+
+    for (; i < size; i++) {
+        *rdram_addr(rdram, (vaddr + i) ^ 3) = src[i];
+    }
+}
+
+// Every byte of a filled word has the same value, so only the head and tail need swizzling
+void fill_rdram(uint8_t* rdram, int32_t ptr, uint8_t value, size_t size) {
+    uint64_t vaddr = static_cast<uint64_t>(static_cast<int64_t>(ptr));
+    size_t i = 0;
+
+    for (; i < size && (vaddr + i) % 4 != 0; i++) {
+        *rdram_addr(rdram, (vaddr + i) ^ 3) = value;
+    }
+
+    size_t words = (size - i) / 4;
+    std::memset(rdram_addr(rdram, vaddr + i), value, words * 4);
+    i += words * 4;
+
+    for (; i < size; i++) {
+        *rdram_addr(rdram, (vaddr + i) ^ 3) = value;
+    }
+}
+
+void copy_halfwords_to_rdram(uint8_t* rdram, int32_t ptr, const int16_t* src, size_t count, size_t stride) {
+    uint64_t vaddr = static_cast<uint64_t>(static_cast<int64_t>(ptr));
+    size_t i = 0;
+
+    for (; i < count && (vaddr + i * 2) % 4 != 0; i++) {
+        std::memcpy(rdram_addr(rdram, (vaddr + i * 2) ^ 2), &src[i * stride], sizeof(int16_t));
+    }
+
+    // The first halfword of a pair lands in the upper half of the host word
+    uint8_t* dst = rdram_addr(rdram, vaddr + i * 2);
+    size_t pairs = (count - i) / 2;
+
+    for (size_t p = 0; p < pairs; p++, i += 2) {
+        uint32_t word = (static_cast<uint32_t>(static_cast<uint16_t>(src[i * stride])) << 16) |
+                        static_cast<uint16_t>(src[(i + 1) * stride]);
+        std::memcpy(dst + p * 4, &word, sizeof(word));
+    }
+
+    for (; i < count; i++) {
+        std::memcpy(rdram_addr(rdram, (vaddr + i * 2) ^ 2), &src[i * stride], sizeof(int16_t));
+    }
+}
+
+void copy_halfwords_from_rdram(uint8_t* rdram, int32_t ptr, int16_t* dst, size_t count) {
+    uint64_t vaddr = static_cast<uint64_t>(static_cast<int64_t>(ptr));
+    size_t i = 0;
+
+    for (; i < count && (vaddr + i * 2) % 4 != 0; i++) {
+        std::memcpy(&dst[i], rdram_addr(rdram, (vaddr + i * 2) ^ 2), sizeof(int16_t));
+    }
+
+    const uint8_t* src = rdram_addr(rdram, vaddr + i * 2);
+    size_t pairs = (count - i) / 2;
+
+    for (size_t p = 0; p < pairs; p++, i += 2) {
+        uint32_t word;
+        std::memcpy(&word, src + p * 4, sizeof(word));
+        dst[i] = static_cast<int16_t>(word >> 16);
+        dst[i + 1] = static_cast<int16_t>(word & 0xFFFF);
+    }
+
+    for (; i < count; i++) {
+        std::memcpy(&dst[i], rdram_addr(rdram, (vaddr + i * 2) ^ 2), sizeof(int16_t));
+    }
+}
@@ -1,9 +1,16 @@
 #include <extlib/resource/audiofile.hpp>
 
 #include <algorithm>
-
-#include <mod_recomp.h>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+#include <extlib/handle_pool.hpp>
+#include <extlib/rdram.hpp>
+#include <extlib/silence.hpp>
+#include <extlib/stats.hpp>
 #include <extlib/thread.hpp>
+#include <extlib/trace.hpp>
 
 #include <plog/Log.h>
 
@@ -12,7 +19,35 @@ namespace Resource {
 constexpr int FILE_TTL_SECONDS = 30;
 constexpr size_t CHUNK_SIZE = 1024;
 constexpr int CACHE_INITIAL_CHUNKS = 8;
-constexpr int CACHE_FOLLOWUP_CHUNKS = 32;
+constexpr double LOOKAHEAD_SECONDS = 1.5;
+constexpr size_t MIN_LOOKAHEAD_CHUNKS = 4;
+constexpr size_t MAX_LOOKAHEAD_CHUNKS = 256;
+constexpr size_t GLOBAL_LOOKAHEAD_MAX_CHUNKS = 4096;
+constexpr size_t RESAMPLE_TAIL_FRAMES = 64;
+constexpr size_t MAX_CURSORS = 16;
+constexpr size_t CURSOR_MATCH_FRAMES = 4 * CHUNK_SIZE;
+constexpr int CURSOR_TTL_SECONDS = 2;
+constexpr auto CURSOR_RATE_WINDOW = std::chrono::milliseconds(100);
+constexpr double CURSOR_RATE_SMOOTHING = 0.25;
+constexpr int PRIORITY_SILENCE_SCAN = std::numeric_limits<int>::max();
+constexpr int PRIORITY_TRIM_SCAN = PRIORITY_SILENCE_SCAN - 1;
+constexpr int PRIORITY_SEEK_PREPARE = static_cast<int>(LOOKAHEAD_SECONDS * 1000) + 1;
+constexpr uint32_t SILENCE_KNOWN = 1u << 31;
+constexpr uint32_t SILENCE_MAX_TRACKS = 31;
+constexpr size_t SILENCE_SCAN_CHUNKS = 16;
+constexpr uint32_t SILENCE_TRIM_MAX_SECONDS = 30;
+
+// Task data decoding chunks missing from the silence map
+struct SilenceScan {};
+
+// Task data looking for leading silence to trim
+struct TrimScan {};
+
+// Task data building the decoder's seek tables, after the lookahead of all files
+struct SeekPrepare {};
+
+// Lookahead chunks wanted by the cursors of all audio files
+static std::atomic<size_t> sLookaheadChunks = 0;
 
 inline size_t CHUNK_START(size_t offset) {
     return (offset / CHUNK_SIZE) * CHUNK_SIZE;
@@ -40,14 +75,51 @@ Audiofile::~Audiofile() {
 void Audiofile::open() {
     file->open();
     decoder->open();
+    handlesOpen = true;
     atime.store(std::chrono::steady_clock::now());
 }
 
 void Audiofile::close() {
+    handlePoolRemove(this);
+
+    {
+        std::unique_lock<std::shared_mutex> handleLock(handleMutex);
+        closeHandles();
+    }
+    atime.store(EPOCH);
+    sLookaheadChunks -= lookaheadWanted.exchange(0);
+
+    std::lock_guard<std::mutex> lock(cursorMutex);
+    cursors.clear();
+}
+
+bool Audiofile::closeIdle() {
+    std::unique_lock<std::shared_mutex> handleLock(handleMutex, std::try_to_lock);
+    if (!handleLock.owns_lock()) {
+        return false;
+    }
+
+    closeHandles();
+    return true;
+}
+
+// Callers hold handleMutex. Decoders reopen without probing again, and resume with a seek.
+void Audiofile::openHandles() {
+    if (!handlesOpen) {
+        std::lock_guard<std::mutex> lock(openMutex);
+        if (!handlesOpen) {
+            open();
+        }
+    }
+
+    handlePoolTouch(this);
+    atime.store(std::chrono::steady_clock::now());
+}
+
+void Audiofile::closeHandles() {
     decoder->close();
     file->close();
-    pos.store(0);
-    atime.store(EPOCH);
+    handlesOpen = false;
 }
 
 void Audiofile::probe() {
@@ -55,31 +127,373 @@ void Audiofile::probe() {
     numChunks = (metadata->sampleCount / CHUNK_SIZE) - (metadata->loopStart / CHUNK_SIZE) + 1;
 }
 
+void Audiofile::setChannelMix(AudioApiChannelMix mix, const uint32_t* channelMap, uint32_t mapCount) {
+    auto source = decoder->metadata;
+    if (mix == AUDIOAPI_CHANNEL_MIX_NONE) {
+        return;
+    }
+
+    mixer = std::make_unique<Decoder::ChannelMixer>(mix, source->trackCount, decoder->vorbisChannelOrder(),
+                                                    channelMap, mapCount);
+
+    metadata = std::make_shared<Decoder::Metadata>(*metadata);
+    metadata->trackCount = mixer->outputTracks();
+
+    decodeKey += " mix" + std::to_string(mix);
+    for (uint32_t i = 0; mix == AUDIOAPI_CHANNEL_MIX_REMAP && i < mapCount; i++) {
+        decodeKey += (i == 0 ? ":" : ",") + std::to_string(channelMap[i]);
+    }
+}
+
+void Audiofile::setTargetSampleRate(uint32_t rate) {
+    auto source = decoder->metadata;
+    if (rate == 0 || source->sampleRate == 0 || rate == source->sampleRate) {
+        return;
+    }
+
+    resampler = std::make_unique<Decoder::Resampler>(source->sampleRate, rate);
+
+    metadata = std::make_shared<Decoder::Metadata>(*metadata);
+    metadata->sampleRate = rate;
+    metadata->sampleCount = resampler->toOutput(source->sampleCount);
+    metadata->loopStart = resampler->toOutput(source->loopStart);
+    metadata->loopEnd = std::min<uint32_t>(resampler->toOutput(source->loopEnd), metadata->sampleCount);
+
+    numChunks = (metadata->sampleCount / CHUNK_SIZE) - (metadata->loopStart / CHUNK_SIZE) + 1;
+
+    decodeKey += " rate" + std::to_string(rate);
+}
+
+void Audiofile::setSilenceMode(AudioApiSilenceMode mode) {
+    if (mode != AUDIOAPI_SILENCE_MAP && mode != AUDIOAPI_SILENCE_TRIM_START) {
+        return;
+    }
+
+    if (mode == AUDIOAPI_SILENCE_TRIM_START) {
+        decodeKey += " trim";
+    }
+
+    auto stored = profileKey.empty() ? std::nullopt : silenceFind(profileKey + decodeKey);
+
+    size_t trim = 0;
+    if (stored.has_value()) {
+        trim = stored->trimFrames;
+    } else if (mode == AUDIOAPI_SILENCE_TRIM_START) {
+        trimScanPending = true;
+    }
+
+    if (trim > 0) {
+        trimStart(trim);
+    }
+
+    size_t chunks = (metadata->sampleCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    if (stored.has_value() && stored->silentTracks.size() == chunks) {
+        silentTracks = std::move(stored->silentTracks);
+        silenceStored = true;
+    } else {
+        silentTracks.assign(chunks, 0);
+        silenceUnknown = chunks;
+    }
+
+    silentChunk = std::make_shared<std::vector<int16_t>>(CHUNK_SIZE * metadata->trackCount);
+}
+
+// Frames of digital silence at the start of the mixed source. Looping files are not trimmed past
+// their loop start, so the loop plays exactly as before.
+size_t Audiofile::findLeadingSilence() {
+    auto source = decoder->metadata;
+    if (source->sampleCount == 0) {
+        return 0;
+    }
+
+    size_t limit = std::min<size_t>(source->sampleCount - 1, static_cast<size_t>(source->sampleRate) * SILENCE_TRIM_MAX_SECONDS);
+    if (source->loopCount != 0) {
+        limit = std::min<size_t>(limit, source->loopStart);
+    }
+
+    size_t trackCount = mixer != nullptr ? mixer->outputTracks() : source->trackCount;
+    std::vector<int16_t> buffer(CHUNK_SIZE * trackCount);
+
+    for (size_t offset = 0; offset < limit; offset += CHUNK_SIZE) {
+        size_t count = std::min(CHUNK_SIZE, limit - offset);
+        size_t framesRead = decodeMixed(&buffer, count, offset);
+
+        auto it = std::find_if(buffer.begin(), buffer.begin() + framesRead * trackCount, [](int16_t s) { return s != 0; });
+        if (it != buffer.begin() + framesRead * trackCount) {
+            return offset + (it - buffer.begin()) / trackCount;
+        }
+        if (framesRead != count) {
+            break;
+        }
+    }
+
+    return limit;
+}
+
+// Skips frames of the source, loop points keep pointing at the same audio
+void Audiofile::trimStart(size_t frames) {
+    size_t trimmed = resampler != nullptr ? resampler->toOutput(frames) : frames;
+
+    trimFrames = frames;
+
+    metadata = std::make_shared<Decoder::Metadata>(*metadata);
+    metadata->sampleCount -= std::min<size_t>(trimmed, metadata->sampleCount);
+    metadata->loopStart -= std::min<size_t>(trimmed, metadata->loopStart);
+    metadata->loopEnd -= std::min<size_t>(trimmed, metadata->loopEnd);
+
+    numChunks = (metadata->sampleCount / CHUNK_SIZE) - (metadata->loopStart / CHUNK_SIZE) + 1;
+}
+
+void Audiofile::recordSilence(size_t offset, const std::vector<int16_t>& data) {
+    if (silentTracks.empty()) {
+        return;
+    }
+
+    uint32_t trackCount = metadata->trackCount;
+    uint32_t mask = (1u << std::min(trackCount, SILENCE_MAX_TRACKS)) - 1;
+
+    for (size_t i = 0; i < data.size() && mask != 0; i++) {
+        if (data[i] != 0 && i % trackCount < SILENCE_MAX_TRACKS) {
+            mask &= ~(1u << (i % trackCount));
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> silenceLock(silenceMutex);
+
+    auto& entry = silentTracks[offset / CHUNK_SIZE];
+    if (!(entry & SILENCE_KNOWN)) {
+        silenceUnknown--;
+    }
+    entry = mask | SILENCE_KNOWN;
+}
+
+bool Audiofile::isSilent(size_t offset, uint32_t trackNo) {
+    if (silentTracks.empty() || trackNo >= SILENCE_MAX_TRACKS) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> silenceLock(silenceMutex);
+
+    uint32_t entry = silentTracks[offset / CHUNK_SIZE];
+    return (entry & SILENCE_KNOWN) && (entry & (1u << trackNo));
+}
+
+bool Audiofile::isChunkSilent(size_t offset) {
+    if (silentTracks.empty() || metadata->trackCount > SILENCE_MAX_TRACKS) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> silenceLock(silenceMutex);
+
+    uint32_t silent = SILENCE_KNOWN | ((1u << metadata->trackCount) - 1);
+    return silentTracks[offset / CHUNK_SIZE] == silent;
+}
+
+// Runs on the worker thread at the lowest priority, and writes the map out once it is complete
+void Audiofile::scanSilence() {
+    std::vector<size_t> unknown;
+
+    {
+        std::shared_lock<std::shared_mutex> silenceLock(silenceMutex);
+        for (size_t i = 0; i < silentTracks.size() && unknown.size() < SILENCE_SCAN_CHUNKS; i++) {
+            if (!(silentTracks[i] & SILENCE_KNOWN)) {
+                unknown.push_back(i);
+            }
+        }
+    }
+
+    for (size_t index : unknown) {
+        decodeChunk(index * CHUNK_SIZE);
+    }
+
+    if (silenceUnknown > 0 || silenceStored.exchange(true) || profileKey.empty()) {
+        return;
+    }
+
+    SilenceMap map{ trimFrames, {} };
+    {
+        std::shared_lock<std::shared_mutex> silenceLock(silenceMutex);
+        map.silentTracks = silentTracks;
+    }
+    silenceStore(profileKey + decodeKey, std::move(map));
+}
+
+// Runs on the worker thread. The mod was already given the untrimmed length and loop points, so a
+// trim is only stored and applied from the next registration of the file on.
+void Audiofile::scanLeadingSilence() {
+    size_t trim;
+    {
+        std::shared_lock<std::shared_mutex> handleLock(handleMutex);
+        openHandles();
+        trim = findLeadingSilence();
+    }
+
+    if (trim == trimFrames) {
+        return;
+    }
+
+    // The map of this session is laid out for the untrimmed file, and must not be stored with the trim
+    silenceStored = true;
+
+    if (!profileKey.empty()) {
+        silenceStore(profileKey + decodeKey, SilenceMap{ trim, {} });
+    }
+}
+
+// Decodes frames of the source, with the tracks of metadata
+size_t Audiofile::decodeMixed(std::vector<int16_t>* buffer, size_t count, size_t offset) {
+    if (mixer == nullptr) {
+        return decoder->decode(buffer, count, offset + trimFrames);
+    }
+
+    std::vector<int16_t> decoded(count * decoder->metadata->trackCount);
+    size_t framesRead = decoder->decode(&decoded, count, offset + trimFrames);
+
+    mixer->process(decoded.data(), framesRead, buffer->data());
+
+    return framesRead;
+}
+
+size_t Audiofile::decodeResampled(std::vector<int16_t>* buffer, size_t count, size_t offset) {
+    auto source = decoder->metadata;
+    size_t trackCount = metadata->trackCount;
+
+    auto [ first, last ] = resampler->inputRange(offset, count);
+    size_t start = static_cast<size_t>(std::max<int64_t>(first, 0));
+    size_t end = static_cast<size_t>(std::clamp<int64_t>(last, start, source->sampleCount - trimFrames));
+
+    std::lock_guard<std::mutex> lock(resampleMutex);
+
+    std::vector<int16_t> input((end - start) * trackCount);
+    size_t tailEnd = sourceTailStart + sourceTail.size() / trackCount;
+    size_t have = 0;
+
+    if (start >= sourceTailStart && start < tailEnd) {
+        have = std::min(tailEnd, end) - start;
+        std::copy_n(sourceTail.begin() + (start - sourceTailStart) * trackCount, have * trackCount, input.begin());
+    }
+
+    if (start + have < end) {
+        std::vector<int16_t> decoded((end - start - have) * trackCount);
+        size_t framesRead = decodeMixed(&decoded, end - start - have, start + have);
+
+        if (framesRead != end - start - have) {
+            throw std::runtime_error("Not enough samples read");
+        }
+
+        std::copy(decoded.begin(), decoded.end(), input.begin() + have * trackCount);
+    }
+
+    size_t keep = std::min(end - start, RESAMPLE_TAIL_FRAMES);
+    sourceTail.assign(input.end() - keep * trackCount, input.end());
+    sourceTailStart = end - keep;
+
+    resampler->process(input.data(), start, end - start, trackCount, buffer->data(), offset, count);
+
+    return count;
+}
+
 std::shared_ptr<std::vector<int16_t>> Audiofile::getChunk(size_t offset) {
-    try {
-        std::shared_lock<std::shared_mutex> cacheLock(cacheMutex);
-        auto chunk = cache.at(offset);
+    if (isChunkSilent(offset)) {
         atime.store(std::chrono::steady_clock::now());
-        return chunk;
-    } catch (const std::out_of_range& e) {
-        if (gMainThreadId == std::this_thread::get_id()) {
-            PLOG_DEBUG << "Cache miss " << offset;
+        return silentChunk;
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> cacheLock(cacheMutex);
+        auto it = cache.find(offset);
+        if (it != cache.end()) {
+            atime.store(std::chrono::steady_clock::now());
+            return it->second;
+        }
+    }
+
+    statsMarkMiss();
+
+    // Whoever misses first decodes, the cache and the pending decodes are checked under one lock so
+    // a chunk is never decoded twice at once
+    std::promise<std::shared_ptr<std::vector<int16_t>>> promise;
+    std::shared_future<std::shared_ptr<std::vector<int16_t>>> running;
+
+    {
+        std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
+
+        auto it = cache.find(offset);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        auto decoding = pending.find(offset);
+        if (decoding != pending.end()) {
+            running = decoding->second;
+        } else {
+            pending.emplace(offset, promise.get_future().share());
+        }
+    }
+
+    bool mainThread = gMainThreadId == std::this_thread::get_id();
+
+    if (running.valid()) {
+        if (mainThread) {
+            PLOG_DEBUG << "Cache miss " << offset << ", joining running decode";
         }
+        joinedDecodes++;
+        statsMarkJoinedDecode();
+        return running.get();
     }
 
-    open();
+    if (mainThread) {
+        PLOG_DEBUG << "Cache miss " << offset;
+        syncDecodes++;
+    }
+
+    std::shared_ptr<std::vector<int16_t>> buffer;
+
+    try {
+        buffer = decodeChunk(offset);
+    } catch (...) {
+        {
+            std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
+            pending.erase(offset);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    bool silent = isChunkSilent(offset);
+
+    {
+        std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
+        if (!silent) {
+            cache[offset] = buffer;
+        }
+        pending.erase(offset);
+    }
+
+    promise.set_value(buffer);
+
+    return buffer;
+}
+
+std::shared_ptr<std::vector<int16_t>> Audiofile::decodeChunk(size_t offset) {
+    TraceScope trace("decode", "decode", "offset", offset);
+
+    std::shared_lock<std::shared_mutex> handleLock(handleMutex);
+    openHandles();
 
     size_t framesToRead = std::min(CHUNK_SIZE, metadata->sampleCount - offset - 1);
     auto buffer = std::make_shared<std::vector<int16_t>>(framesToRead * metadata->trackCount);
 
-    size_t framesRead = decoder->decode(buffer.get(), framesToRead, offset);
+    size_t framesRead = resampler != nullptr
+        ? decodeResampled(buffer.get(), framesToRead, offset)
+        : decodeMixed(buffer.get(), framesToRead, offset);
 
     if (framesRead != framesToRead) {
         throw std::runtime_error("Not enough samples read");
     }
 
-    std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
-    cache[offset] = buffer;
+    recordSilence(offset, *buffer);
 
     return buffer;
 }
@@ -90,64 +504,228 @@ void Audiofile::dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t count, ui
         throw std::invalid_argument("Invalid trackNo " + std::to_string(trackNo));
     }
 
+    TraceScope trace("Audiofile::dma", "dma", "offset", offset);
+
+    // Closed by the handle pool or gc, have the file load in the background until it is reopened
+    if (!handlesOpen) {
+        file->prefetch();
+    }
+
     size_t chunkOffset, i;
 
+    markUsed(offset * metadata->trackCount * sizeof(int16_t) / PROFILE_RANGE_SIZE);
+
     for (chunkOffset = CHUNK_START(offset); chunkOffset < CHUNK_END(offset + count); chunkOffset += CHUNK_SIZE) {
         if (chunkOffset >= metadata->sampleCount) {
             break;
         }
 
+        i = std::max(chunkOffset, offset);
+        size_t end = std::min(CHUNK_END(chunkOffset), offset + count);
+
+        if (isSilent(chunkOffset, trackNo)) {
+            fill_rdram(rdram, ptr + static_cast<int32_t>((i - offset) * 2), 0, (end - i) * 2);
+            continue;
+        }
+
         auto chunk = getChunk(chunkOffset);
         auto data = chunk->data();
 
-        for (i = std::max(chunkOffset, offset); i < std::min(CHUNK_END(chunkOffset), offset + count); i++) {
-            MEM_H(ptr, (i - offset) * 2) = data[(i - chunkOffset) * metadata->trackCount + trackNo];
-        }
+        copy_halfwords_to_rdram(rdram, ptr + static_cast<int32_t>((i - offset) * 2),
+                                data + (i - chunkOffset) * metadata->trackCount + trackNo, end - i, metadata->trackCount);
     }
 
-    pos.store(offset);
+    updateCursor(arg2, offset);
     atime.store(std::chrono::steady_clock::now());
 }
 
+// A cursor playing on reaches the DMA a little ahead of its last one. All tracks of a stream are
+// DMAd at the same offset, so they share a cursor.
+void Audiofile::updateCursor(uint32_t key, size_t offset) {
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(cursorMutex);
+
+    Cursor* nearest = nullptr;
+    for (auto& cursor : cursors) {
+        if (cursor.key != key || offset + CHUNK_SIZE < cursor.pos || offset > cursor.pos + CURSOR_MATCH_FRAMES) {
+            continue;
+        }
+        if (nearest == nullptr || std::max(offset, cursor.pos) - std::min(offset, cursor.pos) <
+                                  std::max(offset, nearest->pos) - std::min(offset, nearest->pos)) {
+            nearest = &cursor;
+        }
+    }
+
+    if (nearest != nullptr) {
+        nearest->pos = offset;
+        nearest->lastUse = now;
+
+        // Loops and seeks start a new measurement, the rate carries over
+        if (offset < nearest->ratePos) {
+            nearest->ratePos = offset;
+            nearest->rateStart = now;
+        } else if (now - nearest->rateStart >= CURSOR_RATE_WINDOW) {
+            double seconds = std::chrono::duration<double>(now - nearest->rateStart).count();
+            double rate = (offset - nearest->ratePos) / seconds;
+
+            nearest->rate += (rate - nearest->rate) * CURSOR_RATE_SMOOTHING;
+            nearest->ratePos = offset;
+            nearest->rateStart = now;
+        }
+        return;
+    }
+
+    // New cursors assume playback at the decoded sample rate until measured
+    Cursor cursor{ key, offset, now, static_cast<double>(metadata->sampleRate), offset, now };
+
+    if (cursors.size() < MAX_CURSORS) {
+        cursors.push_back(cursor);
+        return;
+    }
+
+    auto oldest = std::min_element(cursors.begin(), cursors.end(), [](const auto& a, const auto& b) {
+        return a.lastUse < b.lastUse;
+    });
+    *oldest = cursor;
+}
+
+// Drops expired cursors. Without any, playback is assumed to (re)start at the beginning.
+// Callers hold cursorMutex
+void Audiofile::expireCursors() {
+    auto expiry = std::chrono::steady_clock::now() - std::chrono::seconds(CURSOR_TTL_SECONDS);
+    std::erase_if(cursors, [expiry](const auto& cursor) { return cursor.lastUse < expiry; });
+}
+
+std::vector<Audiofile::Cursor> Audiofile::liveCursors() {
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(cursorMutex);
+
+    expireCursors();
+
+    if (cursors.empty()) {
+        return {{ 0, 0, now, static_cast<double>(metadata->sampleRate), 0, now }};
+    }
+
+    return cursors;
+}
+
+// Chunks covering LOOKAHEAD_SECONDS of playback at rate, shrunk evenly across all files while their
+// total is over the global cap
+size_t Audiofile::lookaheadChunks(double rate) {
+    size_t chunks = static_cast<size_t>(std::ceil(rate * LOOKAHEAD_SECONDS / CHUNK_SIZE));
+    size_t total = sLookaheadChunks.load();
+
+    if (total > GLOBAL_LOOKAHEAD_MAX_CHUNKS) {
+        chunks = chunks * GLOBAL_LOOKAHEAD_MAX_CHUNKS / total;
+    }
+
+    return std::clamp(chunks, MIN_LOOKAHEAD_CHUNKS, MAX_LOOKAHEAD_CHUNKS);
+}
+
 std::vector<PreloadTask> Audiofile::getPreloadTasks() {
-    if (cacheStrategy == CacheStrategy::None) {
-        return {};
+    if (preloadRequested.exchange(false)) {
+        return {{ 0, FullPreload{} }};
     }
 
-    if (initialPreload == true) {
+    if (cacheStrategy != CacheStrategy::None && initialPreload == true) {
         initialPreload = false;
         return {{ 0, true }};
     }
 
+    std::vector<PreloadTask> tasks;
+
+    if (!seekPrepared.exchange(true)) {
+        tasks.emplace_back(PRIORITY_SEEK_PREPARE, SeekPrepare{});
+    }
+
+    if (trimScanPending.exchange(false)) {
+        tasks.emplace_back(PRIORITY_TRIM_SCAN, TrimScan{});
+    }
+
+    if (cacheStrategy == CacheStrategy::None) {
+        return tasks;
+    }
+
+    if (!silentTracks.empty() && !silenceStored) {
+        tasks.emplace_back(PRIORITY_SILENCE_SCAN, SilenceScan{});
+    }
+
     if (cacheStrategy == CacheStrategy::Preload) {
-        return {};
+        return tasks;
     }
 
-    std::vector<PreloadTask> tasks;
-    tasks.reserve(CACHE_FOLLOWUP_CHUNKS);
+    auto cursors = liveCursors();
 
-    size_t i, offset = CHUNK_START(pos - 1);
+    size_t wanted = 0;
+    for (const auto& cursor : cursors) {
+        wanted += lookaheadChunks(cursor.rate);
+    }
+    sLookaheadChunks += wanted - lookaheadWanted.exchange(wanted);
 
-    for (i = 1; i <= CACHE_FOLLOWUP_CHUNKS; i++) {
-        offset += CHUNK_SIZE;
-        if (offset >= metadata->sampleCount) {
-            offset = CHUNK_START(metadata->loopStart);
+    // Priorities are the milliseconds until a chunk plays, so chunks of all files are preloaded in the
+    // order they are needed. Chunks ahead of several cursors are queued once, for the nearest one.
+    std::vector<std::pair<size_t, int>> planned;
+    std::unordered_set<size_t> seen;
+
+    for (const auto& cursor : cursors) {
+        size_t offset = CHUNK_START(cursor.pos + CHUNK_SIZE - 1);
+        size_t ahead = offset - cursor.pos;
+        size_t count = lookaheadChunks(cursor.rate);
+
+        for (size_t i = 0; i < count; i++, offset += CHUNK_SIZE, ahead += CHUNK_SIZE) {
+            if (offset >= metadata->sampleCount) {
+                offset = CHUNK_START(metadata->loopStart);
+            }
+
+            double ms = ahead * 1000.0 / std::max(cursor.rate, 1.0);
+            planned.emplace_back(offset, 1 + static_cast<int>(std::min(ms, LOOKAHEAD_SECONDS * 1000)));
+        }
+    }
+
+    std::sort(planned.begin(), planned.end(), [](const auto& a, const auto& b) {
+        return a.second < b.second;
+    });
+
+    for (const auto& [ offset, priority ] : planned) {
+        if (!seen.insert(offset).second) {
+            continue;
         }
 
         {
             std::shared_lock<std::shared_mutex> cacheLock(cacheMutex);
-            if (cache.contains(offset)) {
+            if (cache.contains(offset) || pending.contains(offset)) {
                 continue;
             }
         }
 
-        tasks.emplace_back(i, offset);
+        if (isChunkSilent(offset)) {
+            continue;
+        }
+
+        tasks.emplace_back(priority, offset);
     }
 
     return tasks;
 }
 
 void Audiofile::runPreloadTask(const PreloadTask& task) {
+    if (task.data.type() == typeid(SilenceScan)) {
+        return scanSilence();
+    }
+
+    if (task.data.type() == typeid(TrimScan)) {
+        return scanLeadingSilence();
+    }
+
+    if (task.data.type() == typeid(SeekPrepare)) {
+        std::shared_lock<std::shared_mutex> handleLock(handleMutex);
+        openHandles();
+        decoder->prepareSeek();
+        return;
+    }
+
     if (task.data.type() == typeid(size_t)) {
         size_t offset = std::any_cast<size_t>(task.data);
         getChunk(offset);
@@ -158,6 +736,11 @@ void Audiofile::runPreloadTask(const PreloadTask& task) {
         ? numChunks
         : CACHE_INITIAL_CHUNKS;
 
+    // Explicit preloads cover the whole file, numChunks is only known after probing
+    if (task.data.type() == typeid(FullPreload)) {
+        preloadChunks = CHUNK_END(metadata->sampleCount) / CHUNK_SIZE;
+    }
+
     for (int i = 0; i < preloadChunks; i++) {
         size_t offset = CHUNK_START(i * CHUNK_SIZE);
         if (offset >= metadata->sampleCount) {
@@ -168,7 +751,44 @@ void Audiofile::runPreloadTask(const PreloadTask& task) {
 
 }
 
+// Ranges are measured in decoded bytes, so a range covers fewer frames the more tracks there are
+void Audiofile::preloadRange(size_t range) {
+    size_t frameSize = metadata->trackCount * sizeof(int16_t);
+    size_t start = range * PROFILE_RANGE_SIZE / frameSize;
+    size_t end = std::min<size_t>((range + 1) * PROFILE_RANGE_SIZE / frameSize, metadata->sampleCount);
+
+    for (size_t offset = CHUNK_START(start); offset < end; offset += CHUNK_SIZE) {
+        getChunk(offset);
+    }
+}
+
+MemoryInfo Audiofile::getMemoryInfo() {
+    std::shared_lock<std::shared_mutex> cacheLock(cacheMutex);
+    MemoryInfo info;
+
+    for (const auto& [ offset, chunk ] : cache) {
+        info.cachedBytes += chunk->size() * sizeof(int16_t);
+    }
+    info.entries = cache.size();
+    info.fileBytes = file->residentBytes();
+
+    return info;
+}
+
+size_t Audiofile::getCachedChunks() {
+    std::shared_lock<std::shared_mutex> cacheLock(cacheMutex);
+    return cache.size();
+}
+
 void Audiofile::gc() {
+    if (evictRequested.exchange(false)) {
+        {
+            std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
+            cache.clear();
+        }
+        return close();
+    }
+
     auto atime = this->atime.load();
     if (atime == EPOCH) {
         return;
@@ -179,19 +799,40 @@ void Audiofile::gc() {
         return close();
     }
 
-    if (cacheStrategy == CacheStrategy::None || cacheStrategy == CacheStrategy::PreloadOnUse) {
-        std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
+    // Once nothing streams the file, its lookahead is given back to the files still playing
+    {
+        std::lock_guard<std::mutex> lock(cursorMutex);
+        expireCursors();
+
+        if (cursors.empty()) {
+            sLookaheadChunks -= lookaheadWanted.exchange(0);
+        }
+    }
+
+    if ((cacheStrategy == CacheStrategy::None || cacheStrategy == CacheStrategy::PreloadOnUse) && !keepCache()) {
+        // Chunk of each cursor and how far ahead of it chunks are kept
+        std::vector<std::pair<size_t, size_t>> windows;
+        for (const auto& cursor : liveCursors()) {
+            windows.emplace_back(cursor.pos / CHUNK_SIZE, lookaheadChunks(cursor.rate));
+        }
 
-        size_t curChunk = pos.load() / CHUNK_SIZE;
+        std::unique_lock<std::shared_mutex> cacheLock(cacheMutex);
 
         auto it = cache.begin();
         while (it != cache.end()) {
             size_t thisChunk = it->first / CHUNK_SIZE;
-            size_t dist = (curChunk > thisChunk)
-                ? (numChunks - (curChunk - thisChunk))
-                : (thisChunk - curChunk);
+            bool keep = false;
+
+            // Distance ahead of each cursor, wrapping around the loop
+            for (const auto& [ curChunk, window ] : windows) {
+                size_t dist = (curChunk > thisChunk)
+                    ? (numChunks - (curChunk - thisChunk))
+                    : (thisChunk - curChunk);
+
+                keep = keep || dist <= window || dist >= numChunks - 1;
+            }
 
-            if ((thisChunk >= CACHE_INITIAL_CHUNKS) && (dist > CACHE_FOLLOWUP_CHUNKS) && (dist < numChunks - 1)) {
+            if ((thisChunk >= CACHE_INITIAL_CHUNKS) && !keep) {
                 it = cache.erase(it);
             } else {
                 it++;
@@ -1,20 +1,41 @@
 #include <extlib/resource/generic.hpp>
 
-#include <mod_recomp.h>
+#include <algorithm>
+
+#include <extlib/rdram.hpp>
+#include <extlib/stats.hpp>
+#include <extlib/trace.hpp>
 
 namespace Resource {
 
 constexpr int FILE_TTL_SECONDS = 30;
+constexpr size_t PAGE_SIZE = 64 * 1024;
+constexpr size_t READ_AHEAD_PAGES = 4;
+constexpr size_t RESOURCE_CACHE_MAX_BYTES = 64 * 1024 * 1024;
+constexpr size_t GLOBAL_CACHE_MAX_BYTES = 256 * 1024 * 1024;
+
+// Bytes held in the page caches of all resources
+static std::atomic<size_t> sGlobalCachedBytes = 0;
+
+// Copies count bytes of data starting at start to ptr, zero filling past the end of data
+static void copyClipped(uint8_t* rdram, int32_t ptr, const uint8_t* data, size_t dataSize, size_t start, size_t count) {
+    size_t available = start < dataSize ? std::min(count, dataSize - start) : 0;
+
+    copy_to_rdram(rdram, ptr, data + start, available);
+    fill_rdram(rdram, ptr + static_cast<int32_t>(available), 0, count - available);
+}
 
 Generic::Generic(std::shared_ptr<Vfs::File> file, CacheStrategy cacheStrategy)
     : file(file), cacheStrategy(cacheStrategy) {
 
     if (cacheStrategy == CacheStrategy::Default) {
-        cacheStrategy = CacheStrategy::PreloadOnUse;
+        this->cacheStrategy = CacheStrategy::PreloadOnUse;
     }
 }
 
 Generic::~Generic() {
+    clearPages();
+    unmap();
     close();
 }
 
@@ -24,6 +45,8 @@ void Generic::open() {
 }
 
 void Generic::close() {
+    std::lock_guard<std::mutex> lock(readMutex);
+
     file->close();
     atime.store(EPOCH);
 }
@@ -31,6 +54,8 @@ void Generic::close() {
 std::vector<uint8_t> Generic::read(size_t offset, size_t size) {
     std::vector<uint8_t> buffer(size);
 
+    std::lock_guard<std::mutex> lock(readMutex);
+
     open();
     file->seek(offset, SEEK_SET);
     file->read(buffer.data(), size);
@@ -38,32 +63,194 @@ std::vector<uint8_t> Generic::read(size_t offset, size_t size) {
     return buffer;
 }
 
-void Generic::dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t size, uint32_t arg1, uint32_t arg2) {
+bool Generic::map() {
     {
         std::shared_lock cacheLock(cacheMutex);
+        if (mapping != nullptr || mapFailed) {
+            return mapping != nullptr;
+        }
+    }
+
+    std::unique_lock cacheLock(cacheMutex);
+
+    if (mapping == nullptr && !mapFailed) {
+        mapping = file->map();
+        mapFailed = mapping == nullptr;
+        if (mapping != nullptr) {
+            file->advise(0, file->size(), mapAdvice);
+        }
+    }
+
+    return mapping != nullptr;
+}
+
+void Generic::unmap() {
+    std::unique_lock cacheLock(cacheMutex);
+
+    if (mapping != nullptr) {
+        file->unmap();
+        mapping = nullptr;
+    }
+}
+
+std::vector<uint8_t> Generic::readPage(size_t index) {
+    TraceScope trace("readPage", "io", "page", index);
+
+    size_t start = index * PAGE_SIZE;
+    if (start >= file->size()) {
+        return {};
+    }
+
+    return read(start, std::min(PAGE_SIZE, file->size() - start));
+}
+
+// Only PreloadOnUse pages are bound by the per-resource budget, least recently used pages make room.
+// Preload and PreloadOnUseNoEvict resources keep every page. All of them share the global budget.
+bool Generic::insertPage(size_t index, std::vector<uint8_t>&& data) {
+    std::unique_lock cacheLock(cacheMutex);
+
+    if (pages.contains(index)) {
+        return true;
+    }
+
+    size_t bytes = data.size();
+
+    if (cacheStrategy == CacheStrategy::PreloadOnUse && !keepCache()) {
+        while (!pages.empty() && cachedBytes + bytes > RESOURCE_CACHE_MAX_BYTES) {
+            auto lru = std::min_element(pages.begin(), pages.end(), [](const auto& a, const auto& b) {
+                return a.second.lastUse.load() < b.second.lastUse.load();
+            });
+            cachedBytes -= lru->second.data.size();
+            sGlobalCachedBytes -= lru->second.data.size();
+            pages.erase(lru);
+        }
+    }
+
+    if (sGlobalCachedBytes + bytes > GLOBAL_CACHE_MAX_BYTES) {
+        return false;
+    }
+
+    auto& page = pages.try_emplace(index).first->second;
+    page.data = std::move(data);
+    page.lastUse.store(++useCounter);
+
+    cachedBytes += bytes;
+    sGlobalCachedBytes += bytes;
+    return true;
+}
+
+void Generic::clearPages() {
+    std::unique_lock cacheLock(cacheMutex);
+
+    sGlobalCachedBytes -= cachedBytes;
+    cachedBytes = 0;
+    pages.clear();
+}
+
+void Generic::fillPages(size_t offset, size_t size) {
+    // Mapped files only need the OS to start reading the range in
+    if (map()) {
+        return file->advise(offset, size, Vfs::MapAdvice::WillNeed);
+    }
+
+    size_t last = std::min(offset + size, file->size());
+
+    for (size_t index = offset / PAGE_SIZE; index * PAGE_SIZE < last; index++) {
+        {
+            std::shared_lock cacheLock(cacheMutex);
+            if (pages.contains(index)) {
+                continue;
+            }
+        }
+
+        if (!insertPage(index, readPage(index))) {
+            return;
+        }
+    }
+}
+
+void Generic::dmaPaged(uint8_t* rdram, int32_t ptr, size_t offset, size_t size) {
+    TraceScope trace("Generic::dma", "dma", "offset", offset);
+
+    size_t done = 0;
+
+    markUsed(offset / PROFILE_RANGE_SIZE);
+
+    if (map()) {
+        std::shared_lock cacheLock(cacheMutex);
+
+        // Unmapped by gc in between, fall back to reading pages
+        const uint8_t* data = mapping.load();
+        if (data != nullptr) {
+            copyClipped(rdram, ptr, data, file->size(), offset, size);
 
-        if (offset + size <= cache.size()) {
-            for (size_t i = 0; i < size; i++) {
-                MEM_B(ptr, i) = cache[offset + i];
+            atime.store(std::chrono::steady_clock::now());
+            return;
+        }
+    }
+
+    while (done < size) {
+        size_t index = (offset + done) / PAGE_SIZE;
+        size_t pageOffset = (offset + done) % PAGE_SIZE;
+        size_t count = std::min(size - done, PAGE_SIZE - pageOffset);
+
+        {
+            std::shared_lock cacheLock(cacheMutex);
+
+            auto it = pages.find(index);
+            if (it != pages.end()) {
+                const auto& data = it->second.data;
+                copyClipped(rdram, ptr + static_cast<int32_t>(done), data.data(), data.size(), pageOffset, count);
+
+                it->second.lastUse.store(++useCounter);
+                done += count;
+                continue;
             }
+        }
+
+        statsMarkMiss();
+
+        if (cacheStrategy == CacheStrategy::None) {
+            std::vector<uint8_t> buffer = read(offset + done, size - done);
+
+            copy_to_rdram(rdram, ptr + static_cast<int32_t>(done), buffer.data(), buffer.size());
 
             return;
         }
+
+        std::vector<uint8_t> data = readPage(index);
+        copyClipped(rdram, ptr + static_cast<int32_t>(done), data.data(), data.size(), pageOffset, count);
+
+        insertPage(index, std::move(data));
+        done += count;
     }
 
-    std::vector<uint8_t> buffer = read(offset, size);
+    atime.store(std::chrono::steady_clock::now());
+}
+
+void Generic::dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t size, uint32_t arg1, uint32_t arg2) {
+    dmaPaged(rdram, ptr, offset, size);
 
-    for (size_t i = 0; i < size; i++) {
-        MEM_B(ptr, i) = buffer[i];
+    // The OS reads ahead in mapped files by itself
+    if (mapping != nullptr) {
+        return;
     }
 
-    if (cacheStrategy != CacheStrategy::None && offset == 0 && size >= file->size()) {
-        std::unique_lock cacheLock(cacheMutex);
-        cache = std::move(buffer);
+    if (cacheStrategy == CacheStrategy::PreloadOnUse || cacheStrategy == CacheStrategy::PreloadOnUseNoEvict) {
+        std::lock_guard<std::mutex> lock(pendingPagesMutex);
+
+        size_t next = (offset + size + PAGE_SIZE - 1) / PAGE_SIZE;
+        for (size_t index = next; index < next + READ_AHEAD_PAGES && index * PAGE_SIZE < file->size(); index++) {
+            pendingPages.insert(index);
+        }
     }
 }
 
 std::vector<PreloadTask> Generic::getPreloadTasks() {
+    if (preloadRequested.exchange(false)) {
+        return {{ 0, FullPreload{} }};
+    }
+
     if (cacheStrategy == CacheStrategy::None) {
         return {};
     }
@@ -73,27 +260,50 @@ std::vector<PreloadTask> Generic::getPreloadTasks() {
         if (cacheStrategy == CacheStrategy::Preload) {
             return {{ 0, true }};
         }
-    } else if (cacheStrategy == CacheStrategy::PreloadOnUse ||
-               cacheStrategy == CacheStrategy::PreloadOnUseNoEvict) {
-        return {{ 0, true }};
     }
 
-    return {};
+    std::vector<PreloadTask> tasks;
+    std::lock_guard<std::mutex> lock(pendingPagesMutex);
+
+    for (auto index : pendingPages) {
+        tasks.push_back({ 0, index });
+    }
+    pendingPages.clear();
+
+    return tasks;
 }
 
 void Generic::runPreloadTask(const PreloadTask& task) {
-    {
-        std::shared_lock cacheLock(cacheMutex);
-        if (cache.size() >= file->size()) {
-            return;
-        }
+    if (task.data.type() == typeid(size_t)) {
+        size_t index = std::any_cast<size_t>(task.data);
+        return fillPages(index * PAGE_SIZE, PAGE_SIZE);
     }
 
-    std::unique_lock cacheLock(cacheMutex);
-    cache = std::move(read(0, file->size()));
+    fillPages(0, file->size());
+}
+
+void Generic::preloadRange(size_t range) {
+    fillPages(range * PROFILE_RANGE_SIZE, PROFILE_RANGE_SIZE);
+}
+
+MemoryInfo Generic::getMemoryInfo() {
+    std::shared_lock cacheLock(cacheMutex);
+
+    return {
+        .cachedBytes = cachedBytes,
+        .entries = pages.size(),
+        .fileBytes = file->residentBytes(),
+        .mappedBytes = mapping != nullptr ? file->size() : 0,
+    };
 }
 
 void Generic::gc() {
+    if (evictRequested.exchange(false)) {
+        clearPages();
+        unmap();
+        return close();
+    }
+
     auto atime = this->atime.load();
     if (atime == EPOCH) {
         return;
@@ -101,8 +311,9 @@ void Generic::gc() {
 
     auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - atime);
     if (elapsed.count() > FILE_TTL_SECONDS) {
-        if (cacheStrategy == CacheStrategy::PreloadOnUse) {
-            cache.resize(0);
+        if (cacheStrategy == CacheStrategy::PreloadOnUse && !keepCache()) {
+            clearPages();
+            unmap();
         }
         return close();
     }
@@ -1,44 +1,90 @@
 #include <extlib/resource/samplebank.hpp>
 
-#include <mod_recomp.h>
+#include <algorithm>
 
 namespace Resource {
 
+constexpr size_t SAMPLE_UNKNOWN_PREFETCH = 64 * 1024;
+
 SampleBank::SampleBank(std::shared_ptr<Vfs::File> file, CacheStrategy cacheStrategy)
     : Generic(file, cacheStrategy) {
 
     if (cacheStrategy == CacheStrategy::Default) {
-        cacheStrategy = CacheStrategy::PreloadOnUse;
+        this->cacheStrategy = CacheStrategy::PreloadOnUse;
     }
+
+    // Samples are fetched in whatever order the sequences play them
+    mapAdvice = Vfs::MapAdvice::Random;
 }
 
 SampleBank::~SampleBank() {
     close();
 }
 
-void SampleBank::dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t size, uint32_t devAddr, uint32_t arg2) {
-    {
-        std::shared_lock cacheLock(cacheMutex);
+// Returns the size of the sample starting at devAddr. Sizes passed along by AudioLoad_RelocateSample
+// are exact, otherwise the sample is assumed to reach the next known sample start, grown to cover
+// the furthest DMA seen so far and capped at SAMPLE_UNKNOWN_PREFETCH.
+size_t SampleBank::learnSample(size_t devAddr, size_t sampleSize, size_t end) {
+    std::lock_guard<std::mutex> lock(sampleSizesMutex);
+
+    if (sampleSize != 0) {
+        sampleSizes[devAddr] = sampleSize;
+        return sampleSize;
+    }
+
+    auto it = sampleSizes.find(devAddr);
+    if (it != sampleSizes.end() && it->second >= end - devAddr) {
+        return it->second;
+    }
+
+    size_t limit = std::min(devAddr + SAMPLE_UNKNOWN_PREFETCH, file->size());
+    auto next = sampleSizes.upper_bound(devAddr);
+    if (next != sampleSizes.end()) {
+        limit = std::min(limit, next->first);
+    }
+
+    sampleSize = std::max(limit, end) - devAddr;
+    sampleSizes[devAddr] = sampleSize;
+    return sampleSize;
+}
+
+void SampleBank::dma(uint8_t* rdram, int32_t ptr, size_t offset, size_t size, uint32_t devAddr, uint32_t sampleSize) {
+    dmaPaged(rdram, ptr, offset + devAddr, size);
 
-        if (offset + devAddr + size <= cache.size()) {
-            for (size_t i = 0; i < size; i++) {
-                MEM_B(ptr, i) = cache[offset + devAddr + i];
-            }
+    if (cacheStrategy != CacheStrategy::PreloadOnUse && cacheStrategy != CacheStrategy::PreloadOnUseNoEvict) {
+        return;
+    }
 
-            return;
-        }
+    learnSample(devAddr, sampleSize, devAddr + offset + size);
+
+    // Fetch the pages holding the rest of the sample on the worker thread
+    std::lock_guard<std::mutex> lock(pendingSamplesMutex);
+    pendingSamples.insert(devAddr);
+}
+
+std::vector<PreloadTask> SampleBank::getPreloadTasks() {
+    if (cacheStrategy == CacheStrategy::Preload || preloadRequested) {
+        return Generic::getPreloadTasks();
     }
 
-    std::vector<uint8_t> buffer = read(offset + devAddr, size);
+    std::vector<PreloadTask> tasks;
+    std::lock_guard<std::mutex> lock(pendingSamplesMutex);
 
-    for (size_t i = 0; i < size; i++) {
-        MEM_B(ptr, i) = buffer[i];
+    for (auto devAddr : pendingSamples) {
+        tasks.push_back({ 0, devAddr });
     }
+    pendingSamples.clear();
+
+    return tasks;
+}
 
-    if (cacheStrategy != CacheStrategy::None && offset == 0 && size >= file->size()) {
-        std::unique_lock cacheLock(cacheMutex);
-        cache = std::move(buffer);
+void SampleBank::runPreloadTask(const PreloadTask& task) {
+    if (task.data.type() != typeid(size_t)) {
+        return Generic::runPreloadTask(task);
     }
+
+    size_t devAddr = std::any_cast<size_t>(task.data);
+    fillPages(devAddr, learnSample(devAddr, 0, devAddr));
 }
 
 } // namespace Resource
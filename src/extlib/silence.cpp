@@ -0,0 +1,119 @@
+#include <extlib/silence.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include <plog/Log.h>
+
+// Silence maps of audio files scanned in earlier sessions, so files do not have to be decoded in
+// full again to know where they are silent. Maps are run length encoded, most chunks of a file
+// are either fully silent or not silent at all.
+
+constexpr const char* SILENCE_MAGIC = "AUDIOAPI_SILENCE 1";
+constexpr size_t SILENCE_MAX_ENTRIES = 1024;
+
+static fs::path sSilencePath;
+static std::map<std::string, SilenceMap> sSilenceMaps;
+static std::mutex sSilenceMutex;
+
+// Format: magic line, then one "<trimFrames> <chunks> <runs> [<mask> <count>]... <key>" line per file
+void silenceLoad(fs::path path) {
+    std::lock_guard<std::mutex> lock(sSilenceMutex);
+
+    sSilencePath = path;
+
+    std::ifstream stream(path);
+    if (!stream.is_open()) {
+        return;
+    }
+
+    std::string line;
+    if (!std::getline(stream, line) || line != SILENCE_MAGIC) {
+        PLOG_ERROR << "Ignoring invalid silence maps: " << path;
+        return;
+    }
+
+    size_t trimFrames, chunks, runs;
+    while (stream >> trimFrames >> chunks >> runs) {
+        SilenceMap map{ trimFrames, {} };
+        map.silentTracks.reserve(chunks);
+
+        uint32_t mask;
+        size_t count;
+        for (size_t i = 0; i < runs && stream >> mask >> count; i++) {
+            map.silentTracks.insert(map.silentTracks.end(), std::min(count, chunks - map.silentTracks.size()), mask);
+        }
+
+        if (!std::getline(stream >> std::ws, line) || map.silentTracks.size() != chunks) {
+            PLOG_ERROR << "Ignoring invalid silence maps: " << path;
+            sSilenceMaps.clear();
+            return;
+        }
+
+        sSilenceMaps[line] = std::move(map);
+    }
+
+    PLOG_DEBUG << "Loaded silence maps for " << sSilenceMaps.size() << " files";
+}
+
+std::optional<SilenceMap> silenceFind(const std::string& key) {
+    std::lock_guard<std::mutex> lock(sSilenceMutex);
+
+    auto it = sSilenceMaps.find(key);
+    if (it == sSilenceMaps.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+void silenceStore(const std::string& key, SilenceMap map) {
+    std::lock_guard<std::mutex> lock(sSilenceMutex);
+
+    if (sSilenceMaps.size() >= SILENCE_MAX_ENTRIES && !sSilenceMaps.contains(key)) {
+        sSilenceMaps.erase(sSilenceMaps.begin());
+    }
+    sSilenceMaps[key] = std::move(map);
+
+    if (sSilencePath.empty()) {
+        return;
+    }
+
+    // Written next to the maps and renamed, so a crash never leaves a truncated file
+    auto tmpPath = sSilencePath;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream stream(tmpPath, std::ios::trunc);
+        if (!stream.is_open()) {
+            PLOG_ERROR << "Could not write silence maps: " << tmpPath;
+            return;
+        }
+
+        stream << SILENCE_MAGIC << "\n";
+        for (const auto& [ entryKey, entry ] : sSilenceMaps) {
+            std::vector<std::pair<uint32_t, size_t>> runs;
+            for (uint32_t mask : entry.silentTracks) {
+                if (!runs.empty() && runs.back().first == mask) {
+                    runs.back().second++;
+                } else {
+                    runs.emplace_back(mask, 1);
+                }
+            }
+
+            stream << entry.trimFrames << " " << entry.silentTracks.size() << " " << runs.size();
+            for (const auto& [ mask, count ] : runs) {
+                stream << " " << mask << " " << count;
+            }
+            stream << " " << entryKey << "\n";
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, sSilencePath, ec);
+    if (ec) {
+        PLOG_ERROR << "Could not write silence maps: " << ec.message();
+    }
+}
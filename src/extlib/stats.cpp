@@ -0,0 +1,151 @@
+#include <extlib/stats.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+
+#include <extlib/thread.hpp>
+
+// DMA latency statistics. Latencies go into log-linear histograms (HDR style): values below
+// 2^SUB_BUCKET_BITS+1 ns are exact, above that every power of two is split into 2^SUB_BUCKET_BITS
+// buckets, so every value is recorded with under 7% error and recording is lock free.
+
+constexpr unsigned SUB_BUCKET_BITS = 4;
+constexpr unsigned SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+constexpr unsigned EXACT_BUCKETS = SUB_BUCKETS * 2;
+constexpr unsigned MAX_EXPONENT = 40;
+constexpr unsigned HISTOGRAM_BUCKETS = EXACT_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+struct DmaStats {
+    std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> buckets{};
+    std::atomic<uint64_t> dmaCount = 0;
+    std::atomic<uint64_t> hitCount = 0;
+    std::atomic<uint64_t> missCount = 0;
+    std::atomic<uint64_t> errorCount = 0;
+    std::atomic<uint64_t> bytesServed = 0;
+    std::atomic<uint64_t> latencySum = 0;
+    std::atomic<uint64_t> latencyMax = 0;
+};
+
+static std::array<DmaStats, AUDIOAPI_STATS_MAX> sStats;
+static std::atomic<uint64_t> sJoinedDecodes = 0;
+static thread_local bool tDmaMiss = false;
+
+static unsigned bucketIndex(uint64_t value) {
+    if (value < EXACT_BUCKETS) {
+        return value;
+    }
+
+    unsigned exponent = std::min<unsigned>(std::bit_width(value) - 1, MAX_EXPONENT);
+    unsigned sub = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+
+    return std::min(EXACT_BUCKETS + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + sub, HISTOGRAM_BUCKETS - 1);
+}
+
+// Midpoint of the values that land in a bucket
+static uint64_t bucketValue(unsigned index) {
+    if (index < EXACT_BUCKETS) {
+        return index;
+    }
+
+    unsigned exponent = (index - EXACT_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS + 1;
+    uint64_t sub = (index - EXACT_BUCKETS) % SUB_BUCKETS;
+    uint64_t width = uint64_t(1) << (exponent - SUB_BUCKET_BITS);
+
+    return (uint64_t(1) << exponent) + sub * width + width / 2;
+}
+
+static uint64_t percentile(const DmaStats& stats, uint64_t total, double p) {
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(total * p + 0.5));
+    uint64_t seen = 0;
+
+    for (unsigned i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += stats.buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return bucketValue(i);
+        }
+    }
+
+    return stats.latencyMax.load(std::memory_order_relaxed);
+}
+
+static void record(DmaStats& stats, uint64_t latencyNs, size_t bytes, bool ok, bool miss) {
+    stats.dmaCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (!ok) {
+        stats.errorCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    (miss ? stats.missCount : stats.hitCount).fetch_add(1, std::memory_order_relaxed);
+    stats.bytesServed.fetch_add(bytes, std::memory_order_relaxed);
+    stats.latencySum.fetch_add(latencyNs, std::memory_order_relaxed);
+    stats.buckets[bucketIndex(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = stats.latencyMax.load(std::memory_order_relaxed);
+    while (latencyNs > max && !stats.latencyMax.compare_exchange_weak(max, latencyNs, std::memory_order_relaxed)) {
+    }
+}
+
+static uint32_t clamp32(uint64_t value) {
+    return static_cast<uint32_t>(std::min<uint64_t>(value, UINT32_MAX));
+}
+
+void statsMarkMiss() {
+    tDmaMiss = true;
+}
+
+void statsMarkJoinedDecode() {
+    sJoinedDecodes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void statsBeginDma() {
+    tDmaMiss = false;
+}
+
+void statsEndDma(AudioApiStatsType type, uint64_t latencyNs, size_t bytes, bool ok) {
+    record(sStats[AUDIOAPI_STATS_ALL], latencyNs, bytes, ok, tDmaMiss);
+    if (type != AUDIOAPI_STATS_ALL && type < AUDIOAPI_STATS_MAX) {
+        record(sStats[type], latencyNs, bytes, ok, tDmaMiss);
+    }
+}
+
+// Counters are read one by one while DMAs may still be recorded, so a snapshot can be off by
+// the few DMAs in flight
+void statsGet(AudioApiStatsType type, AudioApiStreamingStats* out) {
+    const auto& stats = sStats[type < AUDIOAPI_STATS_MAX ? type : AUDIOAPI_STATS_ALL];
+
+    uint64_t served = stats.hitCount.load(std::memory_order_relaxed) + stats.missCount.load(std::memory_order_relaxed);
+
+    out->dmaCount = clamp32(stats.dmaCount.load(std::memory_order_relaxed));
+    out->hitCount = clamp32(stats.hitCount.load(std::memory_order_relaxed));
+    out->missCount = clamp32(stats.missCount.load(std::memory_order_relaxed));
+    out->errorCount = clamp32(stats.errorCount.load(std::memory_order_relaxed));
+    out->kibServed = clamp32(stats.bytesServed.load(std::memory_order_relaxed) / 1024);
+    out->latencyMeanNs = clamp32(served > 0 ? stats.latencySum.load(std::memory_order_relaxed) / served : 0);
+    out->latencyP50Ns = clamp32(served > 0 ? percentile(stats, served, 0.50) : 0);
+    out->latencyP90Ns = clamp32(served > 0 ? percentile(stats, served, 0.90) : 0);
+    out->latencyP99Ns = clamp32(served > 0 ? percentile(stats, served, 0.99) : 0);
+    out->latencyMaxNs = clamp32(stats.latencyMax.load(std::memory_order_relaxed));
+    out->preloadQueueDepth = clamp32(preloadQueueDepth());
+    out->joinedDecodes = type == AUDIOAPI_STATS_ALL || type == AUDIOAPI_STATS_AUDIO_FILE || type >= AUDIOAPI_STATS_MAX
+        ? clamp32(sJoinedDecodes.load(std::memory_order_relaxed))
+        : 0;
+}
+
+void statsReset() {
+    for (auto& stats : sStats) {
+        for (auto& bucket : stats.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        stats.dmaCount = 0;
+        stats.hitCount = 0;
+        stats.missCount = 0;
+        stats.errorCount = 0;
+        stats.bytesServed = 0;
+        stats.latencySum = 0;
+        stats.latencyMax = 0;
+    }
+    sJoinedDecodes = 0;
+}
@@ -12,10 +12,13 @@
 #include <plog/Log.h>
 
 #include <extlib/main.hpp>
+#include <extlib/profile.hpp>
 #include <extlib/resource/abstract.hpp>
+#include <extlib/trace.hpp>
 #include <extlib/utils.hpp>
 
 constexpr int GC_INTERVAL_SECONDS = 1;
+constexpr int PROFILE_SAVE_INTERVAL_SECONDS = 60;
 
 std::thread::id gMainThreadId = std::this_thread::get_id();
 std::thread::id gWorkerThreadId;
@@ -27,6 +30,7 @@ static std::unordered_set<size_t> sPreloadRequests;
 static std::mutex sPreloadMutex;
 
 static std::chrono::steady_clock::time_point sLastGc = EPOCH;
+static std::chrono::steady_clock::time_point sLastProfileSave = std::chrono::steady_clock::now();
 
 
 void drainPreload();
@@ -38,6 +42,7 @@ void workerThreadNotify() {
 
 void workerThreadLoop() {
     gWorkerThreadId = std::this_thread::get_id();
+    traceSetThreadName("worker");
 
     while (true) {
         {
@@ -53,6 +58,13 @@ void workerThreadLoop() {
             gc();
             sLastGc = std::chrono::steady_clock::now();
         }
+
+        elapsed = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - sLastProfileSave);
+
+        if (elapsed.count() > PROFILE_SAVE_INTERVAL_SECONDS) {
+            profileSave();
+            sLastProfileSave = std::chrono::steady_clock::now();
+        }
     }
 }
 
@@ -61,7 +73,14 @@ void queuePreload(size_t resourceId) {
     sPreloadRequests.insert(resourceId);
 }
 
+size_t preloadQueueDepth() {
+    std::unique_lock<std::mutex> preloadLock(sPreloadMutex);
+    return sPreloadRequests.size();
+}
+
 void drainPreload() {
+    TraceScope trace("drainPreload", "preload");
+
     std::unordered_set<size_t> preloadRequests;
     std::vector<std::pair<Resource::ResourcePtr, Resource::PreloadTask>> tasks;
 
@@ -91,6 +110,8 @@ void drainPreload() {
     });
 
     for (const auto& [ resource, task ] : tasks) {
+        TraceScope taskTrace("runPreloadTask", "preload", "priority", task.priority);
+
         try {
             resource->runPreloadTask(task);
         } catch (const std::runtime_error& e) {
@@ -98,10 +119,16 @@ void drainPreload() {
         } catch (...) {
             PLOG_ERROR << "Error running preload task: Unknown error";
         }
+
+        if (task.data.type() == typeid(Resource::FullPreload)) {
+            resource->preloadFinished();
+        }
     }
 }
 
 void gc() {
+    TraceScope trace("gc", "gc");
+
     std::shared_lock<std::shared_mutex> lock(gResourceDataMutex);
 
     for (const auto& [ resourceId, resource ] : gResourceData) {
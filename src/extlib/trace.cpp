@@ -0,0 +1,152 @@
+#include <extlib/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Tracing of extlib activity in the Chrome trace event format (chrome://tracing, Perfetto).
+// Every thread that records an event gets a ring buffer that keeps its most recent events,
+// a dump writes all of them to a JSON file in mod_data.
+
+constexpr size_t TRACE_BUFFER_EVENTS = 16384;
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    const char* argName;
+    uint64_t arg;
+    uint64_t start;
+    uint64_t end;
+};
+
+struct TraceBuffer {
+    std::string threadName;
+    size_t tid;
+    size_t count = 0;
+    std::array<TraceEvent, TRACE_BUFFER_EVENTS> events;
+    // Only contended while dumping
+    std::mutex mutex;
+};
+
+std::atomic<bool> gTraceEnabled = false;
+
+static const auto sTraceEpoch = std::chrono::steady_clock::now();
+static fs::path sTraceDir;
+static std::vector<std::shared_ptr<TraceBuffer>> sTraceBuffers;
+static std::mutex sTraceMutex;
+
+// Set before the buffer exists, so naming a thread does not allocate one while tracing is off
+static thread_local const char* tThreadName = nullptr;
+
+// Buffers outlive their threads so events of short lived threads still make it into the dump
+static TraceBuffer& threadBuffer() {
+    thread_local std::shared_ptr<TraceBuffer> buffer;
+
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(sTraceMutex);
+
+        buffer = std::make_shared<TraceBuffer>();
+        buffer->tid = sTraceBuffers.size() + 1;
+        buffer->threadName = tThreadName != nullptr ? tThreadName : "thread " + std::to_string(buffer->tid);
+        sTraceBuffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+void traceSetOutputDir(fs::path dir) {
+    std::lock_guard<std::mutex> lock(sTraceMutex);
+    sTraceDir = dir;
+}
+
+void traceSetThreadName(const char* name) {
+    tThreadName = name;
+}
+
+void traceEnable(bool enabled) {
+    gTraceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Nanoseconds since the library was loaded, never 0 so TraceScope can use 0 as disabled
+uint64_t traceNow() {
+    auto elapsed = std::chrono::steady_clock::now() - sTraceEpoch;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() + 1;
+}
+
+void traceRecord(const char* name, const char* category, uint64_t start, const char* argName, uint64_t arg) {
+    uint64_t end = traceNow();
+    auto& buffer = threadBuffer();
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events[buffer.count % TRACE_BUFFER_EVENTS] = { name, category, argName, arg, start, end };
+    buffer.count++;
+}
+
+fs::path traceDump() {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    fs::path dir;
+
+    {
+        std::lock_guard<std::mutex> lock(sTraceMutex);
+        buffers = sTraceBuffers;
+        dir = sTraceDir;
+    }
+
+    char filename[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(filename, sizeof(filename), "audio_api_trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+    auto path = dir / filename;
+
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Could not open " + path.string());
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"audio_api extlib\"}}";
+
+    for (const auto& buffer : buffers) {
+        std::vector<TraceEvent> events;
+        std::string threadName;
+
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+
+            size_t first = buffer->count > TRACE_BUFFER_EVENTS ? buffer->count - TRACE_BUFFER_EVENTS : 0;
+            for (size_t i = first; i < buffer->count; i++) {
+                events.push_back(buffer->events[i % TRACE_BUFFER_EVENTS]);
+            }
+            threadName = buffer->threadName;
+        }
+
+        out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"name\":\"thread_name\",\"args\":{\"name\":\"" << threadName << "\"}}";
+
+        for (const auto& event : events) {
+            out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\""
+                << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0;
+            if (event.argName != nullptr) {
+                out << ",\"args\":{\"" << event.argName << "\":" << event.arg << "}";
+            }
+            out << "}";
+        }
+    }
+
+    out << "\n]}\n";
+
+    if (!out) {
+        throw std::runtime_error("Could not write " + path.string());
+    }
+
+    return path;
+}
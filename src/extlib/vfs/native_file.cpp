@@ -1,5 +1,18 @@
 #include <extlib/vfs/native_file.hpp>
 
+#include <algorithm>
+
+#include <extlib/trace.hpp>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
 namespace Vfs {
 
 NativeFile::NativeFile(fs::path path)
@@ -16,6 +29,13 @@ NativeFile::NativeFile(fs::path path)
 }
 
 NativeFile::~NativeFile() {
+    unmap();
+}
+
+int64_t NativeFile::modifiedTime() {
+    std::error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
 }
 
 void NativeFile::open() {
@@ -23,6 +43,7 @@ void NativeFile::open() {
         return;
     }
 
+    TraceScope trace("NativeFile::open", "vfs");
     std::lock_guard<std::mutex> lock(mutex);
 
     stream.open(path, std::ios::binary);
@@ -37,6 +58,7 @@ void NativeFile::close() {
 }
 
 size_t NativeFile::read(void* buffer, size_t bytes) {
+    TraceScope trace("NativeFile::read", "vfs", "bytes", bytes);
     std::lock_guard<std::mutex> lock(mutex);
 
     stream.read(reinterpret_cast<char*>(buffer), bytes);
@@ -90,4 +112,85 @@ int64_t NativeFile::tell() {
     return pos;
 }
 
+// The mapping doesn't need the file to stay open, handles are closed right away
+const uint8_t* NativeFile::map() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (mapping != nullptr || filesize == 0) {
+        return mapping;
+    }
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    HANDLE fileMapping = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle);
+    if (fileMapping == NULL) {
+        return nullptr;
+    }
+
+    mapping = static_cast<const uint8_t*>(MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(fileMapping);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    void* addr = mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr != MAP_FAILED) {
+        mapping = static_cast<const uint8_t*>(addr);
+    }
+#endif
+
+    return mapping;
+}
+
+void NativeFile::unmap() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (mapping == nullptr) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping);
+#else
+    munmap(const_cast<uint8_t*>(mapping), filesize);
+#endif
+
+    mapping = nullptr;
+}
+
+// Hints are best effort, Windows has no equivalent for most of them
+void NativeFile::advise(size_t offset, size_t size, MapAdvice advice) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (mapping == nullptr || offset >= filesize) {
+        return;
+    }
+
+    size = std::min(size, filesize - offset);
+
+#if !defined(_WIN32)
+    // madvise needs a page aligned start
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = offset - offset % pageSize;
+
+    int flags;
+    switch (advice) {
+    case MapAdvice::Sequential: flags = MADV_SEQUENTIAL; break;
+    case MapAdvice::Random:     flags = MADV_RANDOM; break;
+    case MapAdvice::WillNeed:   flags = MADV_WILLNEED; break;
+    default:                    flags = MADV_NORMAL; break;
+    }
+
+    madvise(const_cast<uint8_t*>(mapping) + start, size + offset - start, flags);
+#endif
+}
+
 } // namespace Vfs
@@ -33,6 +33,10 @@ ZipArchive::ZipArchive(ZipArchive::Private, fs::path path)
     }
 
     filesize = static_cast<size_t>(stream.tellg());
+
+    std::error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    mtime = ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
     stream.seekg(0, std::ios::beg);
 
     data.resize(filesize);
@@ -51,6 +55,17 @@ std::shared_ptr<ZipArchive> ZipArchive::checkCache(fs::path path) {
     }
 }
 
+size_t ZipArchive::totalResidentBytes() {
+    std::shared_lock<std::shared_mutex> cacheLock(cacheMutex);
+    size_t bytes = 0;
+
+    for (const auto& [ path, archive ] : cache) {
+        bytes += archive->data.size();
+    }
+
+    return bytes;
+}
+
 std::shared_ptr<ZipArchive> ZipArchive::factory(fs::path path) {
     fs::path normalized = path.lexically_normal();
 
@@ -149,8 +164,10 @@ ZipArchive::FileInfo ZipArchive::locateFile(std::string path) {
 }
 
 void ZipArchive::extractFileToBuffer(std::string path, std::vector<uint8_t>& buffer) {
-    auto info = locateFile(path);
+    extractEntryToBuffer(locateFile(path), buffer);
+}
 
+void ZipArchive::extractEntryToBuffer(const FileInfo& info, std::vector<uint8_t>& buffer) {
     std::lock_guard<std::mutex> lock(mutex);
 
     mz_zip_archive* mz_archive = static_cast<mz_zip_archive*>(this->mz_archive);
@@ -0,0 +1,227 @@
+#include <extlib/vfs/zip_entry_cache.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <plog/Log.h>
+
+#include <extlib/trace.hpp>
+
+namespace Vfs {
+
+constexpr size_t ZIP_ENTRY_CACHE_MAX_BYTES = 64 * 1024 * 1024;
+
+using Key = std::pair<const ZipArchive*, size_t>;
+using Promise = std::shared_ptr<std::promise<ZipEntryCache::Data>>;
+
+struct Entry {
+    std::shared_future<ZipEntryCache::Data> data;
+    size_t bytes = 0;
+    size_t refs = 0;
+    uint64_t lastUse = 0;
+    bool loaded = false;
+    bool failed = false;
+};
+
+struct Job {
+    std::shared_ptr<ZipArchive> archive;
+    ZipArchive::FileInfo info;
+    Promise promise;
+};
+
+// Archives are never unloaded, so their address identifies them
+static std::map<Key, Entry> sEntries;
+static size_t sTotalBytes = 0;
+static size_t sRetainedBytes = 0;
+static uint64_t sUseCounter = 0;
+static std::mutex sEntryMutex;
+
+// Prefetches, inflated one at a time by a single thread started on the first one. It stays alive
+// between bursts so tracing only ever gives it one buffer. The signal is never destroyed, the
+// thread is still waiting on it at exit.
+static std::deque<Job> sJobs;
+static std::condition_variable& sInflateThreadSignal = *new std::condition_variable();
+static bool sInflateThreadStarted = false;
+
+// Drops the least recently released entries no file has open while over the budget
+static void trim() {
+    while (sRetainedBytes > ZIP_ENTRY_CACHE_MAX_BYTES) {
+        auto lru = sEntries.end();
+        for (auto it = sEntries.begin(); it != sEntries.end(); it++) {
+            if (it->second.refs == 0 && it->second.loaded && (lru == sEntries.end() || it->second.lastUse < lru->second.lastUse)) {
+                lru = it;
+            }
+        }
+
+        if (lru == sEntries.end()) {
+            return;
+        }
+
+        sRetainedBytes -= lru->second.bytes;
+        sTotalBytes -= lru->second.bytes;
+        sEntries.erase(lru);
+    }
+}
+
+// Returns the entry, with a new promise to fulfill if nobody is inflating it yet. Callers hold
+// sEntryMutex.
+static Entry& findOrStart(const ZipArchive* archive, size_t index, Promise& promise) {
+    auto& entry = sEntries[{ archive, index }];
+
+    if (!entry.data.valid() || entry.failed) {
+        promise = std::make_shared<std::promise<ZipEntryCache::Data>>();
+        entry.data = promise->get_future().share();
+        entry.failed = false;
+    }
+
+    return entry;
+}
+
+static void inflate(const Job& job) {
+    TraceScope trace("ZipFile::extract", "vfs", "bytes", job.info.size);
+    Key key{ job.archive.get(), job.info.index };
+
+    try {
+        auto buffer = std::make_shared<std::vector<uint8_t>>();
+        job.archive->extractEntryToBuffer(job.info, *buffer);
+
+        {
+            std::lock_guard<std::mutex> lock(sEntryMutex);
+
+            auto& entry = sEntries.at(key);
+            entry.bytes = buffer->size();
+            entry.loaded = true;
+            entry.lastUse = ++sUseCounter;
+            sTotalBytes += entry.bytes;
+
+            if (entry.refs == 0) {
+                sRetainedBytes += entry.bytes;
+                trim();
+            }
+        }
+
+        job.promise->set_value(std::move(buffer));
+
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(sEntryMutex);
+
+            // Waiters still hold references, the next acquire starts over
+            auto it = sEntries.find(key);
+            if (it != sEntries.end() && it->second.refs == 0) {
+                sEntries.erase(it);
+            } else if (it != sEntries.end()) {
+                it->second.failed = true;
+            }
+        }
+
+        job.promise->set_exception(std::current_exception());
+    }
+}
+
+static void inflateThreadLoop() {
+    traceSetThreadName("zip");
+
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(sEntryMutex);
+            sInflateThreadSignal.wait(lock, [] { return !sJobs.empty(); });
+
+            job = std::move(sJobs.front());
+            sJobs.pop_front();
+        }
+
+        try {
+            inflate(job);
+        } catch (...) {
+            PLOG_ERROR << "Zip entry inflate error: Unknown error";
+        }
+    }
+}
+
+ZipEntryCache::Data ZipEntryCache::acquire(std::shared_ptr<ZipArchive> archive, const ZipArchive::FileInfo& info) {
+    Promise promise;
+    std::shared_future<Data> data;
+
+    {
+        std::lock_guard<std::mutex> lock(sEntryMutex);
+
+        auto& entry = findOrStart(archive.get(), info.index, promise);
+        if (entry.refs++ == 0 && entry.loaded) {
+            sRetainedBytes -= entry.bytes;
+        }
+        data = entry.data;
+    }
+
+    if (promise != nullptr) {
+        inflate({ archive, info, promise });
+    }
+
+    try {
+        return data.get();
+    } catch (...) {
+        release(archive.get(), info.index);
+        throw;
+    }
+}
+
+void ZipEntryCache::release(const ZipArchive* archive, size_t index) {
+    std::lock_guard<std::mutex> lock(sEntryMutex);
+
+    auto it = sEntries.find({ archive, index });
+    if (it == sEntries.end() || it->second.refs == 0) {
+        return;
+    }
+
+    auto& entry = it->second;
+    if (--entry.refs > 0) {
+        return;
+    }
+
+    if (entry.failed) {
+        sEntries.erase(it);
+        return;
+    }
+
+    entry.lastUse = ++sUseCounter;
+    if (entry.loaded) {
+        sRetainedBytes += entry.bytes;
+        trim();
+    }
+}
+
+void ZipEntryCache::prefetch(std::shared_ptr<ZipArchive> archive, const ZipArchive::FileInfo& info) {
+    {
+        std::lock_guard<std::mutex> lock(sEntryMutex);
+
+        Promise promise;
+        findOrStart(archive.get(), info.index, promise);
+
+        if (promise == nullptr) {
+            return;
+        }
+
+        sJobs.push_back({ archive, info, promise });
+
+        if (!sInflateThreadStarted) {
+            std::thread(inflateThreadLoop).detach();
+            sInflateThreadStarted = true;
+        }
+    }
+
+    sInflateThreadSignal.notify_one();
+}
+
+size_t ZipEntryCache::totalBytes() {
+    std::lock_guard<std::mutex> lock(sEntryMutex);
+    return sTotalBytes;
+}
+
+} // namespace Vfs
@@ -1,5 +1,7 @@
 #include <extlib/vfs/zip_file.hpp>
 
+#include <extlib/trace.hpp>
+
 namespace Vfs {
 
 ZipFile::ZipFile(std::shared_ptr<ZipArchive> archive, fs::path path)
@@ -10,31 +12,45 @@ ZipFile::ZipFile(std::shared_ptr<ZipArchive> archive, fs::path path)
 }
 
 ZipFile::~ZipFile() {
+    close();
 }
 
 void ZipFile::open() {
-    if (info.compressed && buffer.size() == 0) {
-        std::lock_guard<std::mutex> lock(mutex);
-        archive->extractFileToBuffer(path.string(), buffer);
+    if (!info.compressed) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (entry == nullptr) {
+        entry = ZipEntryCache::acquire(archive, info);
     }
 }
 
 void ZipFile::close() {
     if (info.compressed) {
         std::lock_guard<std::mutex> lock(mutex);
-        buffer.resize(0);
+
+        if (entry != nullptr) {
+            entry = nullptr;
+            ZipEntryCache::release(archive.get(), info.index);
+        }
     }
     curPos = 0;
 }
 
 size_t ZipFile::read(void* ptr, size_t bytes) {
+    TraceScope trace("ZipFile::read", "vfs", "bytes", bytes);
     std::lock_guard<std::mutex> lock(mutex);
     size_t bytesToRead, bytesRead;
 
     if (info.compressed) {
-        bytesToRead = std::min(buffer.size() - curPos, bytes);
+        if (entry == nullptr) {
+            return 0;
+        }
+        bytesToRead = std::min(entry->size() - curPos, bytes);
         bytesRead = bytesToRead;
-        std::copy(buffer.data() + curPos, buffer.data() + curPos + bytesToRead, static_cast<uint8_t*>(ptr));
+        std::copy(entry->data() + curPos, entry->data() + curPos + bytesToRead, static_cast<uint8_t*>(ptr));
     } else {
         bytesToRead = std::min(filesize - curPos, bytes);
         bytesRead = archive->extractBytesToBuffer(ptr, bytesToRead, info.offset + curPos);
@@ -63,4 +79,15 @@ int64_t ZipFile::tell() {
     return curPos;
 }
 
+// Entries change only with their archive
+int64_t ZipFile::modifiedTime() {
+    return archive->modifiedTime();
+}
+
+void ZipFile::prefetch() {
+    if (info.compressed) {
+        ZipEntryCache::prefetch(archive, info);
+    }
+}
+
 } // namespace Vfs
@@ -0,0 +1,81 @@
+/*
+ * master_bus.c — Porcelain API for native DSP on the final mix.
+ *
+ * The RSP mixes each audio frame into an AI buffer, which AudioThread_UpdateImpl hands to the
+ * audio interface two updates later. Right before that, the buffer is run through a chain of
+ * native processors added by mods: biquad EQ bands, a compressor, a lookahead limiter and an
+ * algorithmic reverb. Effects run in the order they were added, across all mods.
+ *
+ *   AddMasterEffect    — appends an effect to the chain, returns its effectId or -1
+ *   UpdateMasterEffect — changes the parameters of an effect, keeping its state (e.g. reverb tail)
+ *   RemoveMasterEffect — takes an effect out of the chain
+ *
+ * The RSP mix saturates at 16 bits before the chain sees it. A limiter at the end of the chain
+ * keeps EQ boosts and reverb from clipping, it can't undo clipping in the RSP mix itself.
+ */
+#include <global.h>
+#include <recomp/modding.h>
+
+#include <audio_api/types.h>
+
+RECOMP_IMPORT(".", s32 AudioApiNative_AddMasterEffect(AudioApiMasterEffect* effect));
+RECOMP_IMPORT(".", bool AudioApiNative_UpdateMasterEffect(s32 effectId, AudioApiMasterEffect* effect));
+RECOMP_IMPORT(".", bool AudioApiNative_RemoveMasterEffect(s32 effectId));
+RECOMP_IMPORT(".", bool AudioApiNative_ProcessMasterBus(s16* aiBuf, u32 numFrames, u32 sampleRate));
+
+// Skips the native call entirely while no mod uses the master bus
+static s32 sMasterEffectCount = 0;
+
+/* Mirrors the buffer selection in AudioThread_UpdateImpl, which runs right after this hook: the
+ * task counter and AI buffer index are advanced, then the buffer rendered two updates ago is
+ * queued to the audio interface. */
+RECOMP_HOOK("AudioThread_UpdateImpl") void on_AudioThread_UpdateImpl_MasterBus() {
+    s32 index;
+
+    if (sMasterEffectCount == 0 || gAudioCtx.resetTimer >= 16) {
+        return;
+    }
+
+    if ((gAudioCtx.totalTaskCount + 1) % gAudioCtx.audioBufferParameters.specUnk4 != 0) {
+        return;
+    }
+
+    index = (gAudioCtx.curAiBufferIndex + 1 + ARRAY_COUNT(gAudioCtx.aiBuffers) - 2) % ARRAY_COUNT(gAudioCtx.aiBuffers);
+
+    if (gAudioCtx.numSamplesPerFrame[index] != 0) {
+        AudioApiNative_ProcessMasterBus(gAudioCtx.aiBuffers[index], gAudioCtx.numSamplesPerFrame[index],
+                                        gAudioCtx.audioBufferParameters.samplingFreq);
+    }
+}
+
+RECOMP_EXPORT s32 AudioApi_AddMasterEffect(AudioApiMasterEffect* effect) {
+    s32 effectId;
+
+    if (effect == NULL) {
+        return -1;
+    }
+
+    effectId = AudioApiNative_AddMasterEffect(effect);
+    if (effectId >= 0) {
+        sMasterEffectCount++;
+    }
+
+    return effectId;
+}
+
+RECOMP_EXPORT bool AudioApi_UpdateMasterEffect(s32 effectId, AudioApiMasterEffect* effect) {
+    if (effect == NULL) {
+        return false;
+    }
+
+    return AudioApiNative_UpdateMasterEffect(effectId, effect);
+}
+
+RECOMP_EXPORT bool AudioApi_RemoveMasterEffect(s32 effectId) {
+    if (!AudioApiNative_RemoveMasterEffect(effectId)) {
+        return false;
+    }
+
+    sMasterEffectCount--;
+    return true;
+}
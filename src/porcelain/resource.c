@@ -16,11 +16,37 @@
  * Loading paths:
  *   Sequence/SoundFont → AddResourceFromFs → AudioApiNative_AddResource  (generic resource loader)
  *   SampleBank         → AddSampleBankFromFs → AudioApiNative_AddSampleBank (sample-specific loader)
- *   AudioFile          → AddAudioFileFromFs → AudioApiNative_AddAudioFile (decoded audio loader)
+ *   AudioFile          → AddAudioFileFromFs(Ex) → AudioApiNative_AddAudioFile (decoded audio loader)
  *
  * GetResourceDevAddr: Returns a virtual "device address" for a loaded resource by registering
  *   the built-in NativeDmaCallback as the DMA handler. The returned uintptr_t is used by the
  *   audio engine to locate resource data during playback via DMA callbacks.
+ *
+ * Residency control (all take a resourceId, return false if it is unknown):
+ *   RemoveResource  — invalidates the resource's device addresses, then drops it and its file handle
+ *   PreloadResource — loads the whole resource into its cache on the worker thread
+ *   Pin/Unpin       — keeps the cache from being trimmed or expired until unpinned
+ *   EvictResource   — drops the cache and closes the file on the worker thread, it is reloaded on the next DMA
+ *
+ * Warm start: the native side records which ranges of each resource were used and saves them to
+ *   mod_data/audio_api.profile. When the API becomes ready the hottest ranges of the registered
+ *   resources are preloaded within SetWarmStartBudget bytes (32 MiB by default, 0 disables).
+ *
+ * Open files: audio files keep their file and decoder open between decodes. Only SetOpenFileLimit
+ *   of them (64 by default) stay open, the least recently used idle ones are closed and reopened
+ *   without probing again when they are next decoded.
+ *
+ * Tracing: SetTracing records DMAs, decodes, preloads, gc passes and file reads on the native side,
+ *   DumpTrace writes the most recent events of every thread to mod_data/audio_api_trace_*.json in
+ *   Chrome trace event format (open in chrome://tracing or Perfetto).
+ *
+ * Streaming stats: every native DMA is timed and counted as a cache hit or a miss (read or decoded
+ *   before returning), globally and per resource type. GetStreamingStats fills a snapshot with the
+ *   counters and latency percentiles since startup or the last ResetStreamingStats.
+ *
+ * Memory accounting: GetResourceMemory lists what every filesystem resource holds (cached chunks or
+ *   pages, extracted zip entries, mapped views) and how long ago it was last used, GetMemoryTotal
+ *   sums it up together with the zip archives kept in memory.
  */
 #include <global.h>
 #include <recomp/modding.h>
@@ -30,10 +56,26 @@
 /* Native implementations imported from the host recomp runtime (".") */
 RECOMP_IMPORT(".", bool AudioApiNative_AddResource(AudioApiResourceInfo* info, char* dir, char* filename));
 RECOMP_IMPORT(".", bool AudioApiNative_AddSampleBank(AudioApiSampleBankInfo* info, char* dir, char* filename));
-RECOMP_IMPORT(".", bool AudioApiNative_AddAudioFile(AudioApiFileInfo* info, char* dir, char* filename));
+RECOMP_IMPORT(".", bool AudioApiNative_AddAudioFile(AudioApiFileInfo* info, char* dir, char* filename, AudioApiFileOptions* options));
+RECOMP_IMPORT(".", bool AudioApiNative_RemoveResource(u32 resourceId));
+RECOMP_IMPORT(".", bool AudioApiNative_PreloadResource(u32 resourceId));
+RECOMP_IMPORT(".", bool AudioApiNative_PinResource(u32 resourceId));
+RECOMP_IMPORT(".", bool AudioApiNative_UnpinResource(u32 resourceId));
+RECOMP_IMPORT(".", bool AudioApiNative_EvictResource(u32 resourceId));
+RECOMP_IMPORT(".", bool AudioApiNative_SetWarmStartBudget(u32 budget));
+RECOMP_IMPORT(".", bool AudioApiNative_SetResampleRate(u32 rate));
+RECOMP_IMPORT(".", bool AudioApiNative_SetOpenFileLimit(u32 limit));
+RECOMP_IMPORT(".", bool AudioApiNative_SetTracing(bool enabled));
+RECOMP_IMPORT(".", bool AudioApiNative_DumpTrace());
+RECOMP_IMPORT(".", bool AudioApiNative_GetStreamingStats(AudioApiStreamingStats* stats, AudioApiStatsType type));
+RECOMP_IMPORT(".", bool AudioApiNative_ResetStreamingStats());
+RECOMP_IMPORT(".", u32 AudioApiNative_GetResourceMemory(AudioApiResourceMemory* entries, u32 maxEntries, AudioApiMemorySort sort));
+RECOMP_IMPORT(".", bool AudioApiNative_GetMemoryTotal(AudioApiMemoryTotal* total));
 RECOMP_IMPORT(".", uintptr_t AudioApi_AddDmaCallback(AudioApiDmaCallback callback, u32 arg0, u32 arg1, u32 arg2));
 RECOMP_IMPORT(".", s32 AudioApi_NativeDmaCallback(void* ramAddr, size_t size, size_t offset, u32 arg0, u32 arg1, u32 arg2));
 
+extern void AudioApi_InvalidateDmaCallbacks(AudioApiDmaCallback callback, u32 arg0);
+
 /* Generic resource loader. Sequences and soundfonts both route here. info=NULL → zero-init defaults. */
 RECOMP_EXPORT bool AudioApi_AddResourceFromFs(AudioApiResourceInfo* info, char* dir, char* filename) {
     AudioApiResourceInfo defaultInfo = {0};
@@ -65,15 +107,26 @@ RECOMP_EXPORT bool AudioApi_AddSampleBankFromFs(AudioApiSampleBankInfo* info, ch
     return AudioApiNative_AddSampleBank(info, dir, filename);
 }
 
-/* Decoded audio file (wav/flac/mp3/vorbis/opus). Distinct info struct with codec/sample params. */
-RECOMP_EXPORT bool AudioApi_AddAudioFileFromFs(AudioApiFileInfo* info, char* dir, char* filename) {
+/* Decoded audio file (wav/flac/mp3/vorbis/opus) with decode options. options=NULL → defaults. The
+ * options struct is versioned by its size field, AudioApiFileInfo keeps its layout so mods built
+ * against older headers keep working. */
+RECOMP_EXPORT bool AudioApi_AddAudioFileFromFsEx(AudioApiFileInfo* info, AudioApiFileOptions* options, char* dir, char* filename) {
     AudioApiFileInfo defaultInfo = {0};
+    AudioApiFileOptions defaultOptions = { .size = sizeof(AudioApiFileOptions) };
 
     if (info == NULL) {
         info = &defaultInfo;
     }
+    if (options == NULL) {
+        options = &defaultOptions;
+    }
 
-    return AudioApiNative_AddAudioFile(info, dir, filename);
+    return AudioApiNative_AddAudioFile(info, dir, filename, options);
+}
+
+/* Decoded audio file (wav/flac/mp3/vorbis/opus). Distinct info struct with codec/sample params. */
+RECOMP_EXPORT bool AudioApi_AddAudioFileFromFs(AudioApiFileInfo* info, char* dir, char* filename) {
+    return AudioApi_AddAudioFileFromFsEx(info, NULL, dir, filename);
 }
 
 /* Returns a device address handle for a resource by binding NativeDmaCallback as its DMA source.
@@ -81,3 +134,69 @@ RECOMP_EXPORT bool AudioApi_AddAudioFileFromFs(AudioApiFileInfo* info, char* dir
 RECOMP_EXPORT uintptr_t AudioApi_GetResourceDevAddr(u32 resourceId, u32 arg1, u32 arg2) {
     return AudioApi_AddDmaCallback(AudioApi_NativeDmaCallback, resourceId, arg1, arg2);
 }
+
+/* Unregisters a resource. Device addresses from GetResourceDevAddr stop working first, so anything
+ * still pointing at the resource fails its DMA instead of reaching a freed resource. */
+RECOMP_EXPORT bool AudioApi_RemoveResource(u32 resourceId) {
+    AudioApi_InvalidateDmaCallbacks(AudioApi_NativeDmaCallback, resourceId);
+    return AudioApiNative_RemoveResource(resourceId);
+}
+
+RECOMP_EXPORT bool AudioApi_PreloadResource(u32 resourceId) {
+    return AudioApiNative_PreloadResource(resourceId);
+}
+
+RECOMP_EXPORT bool AudioApi_PinResource(u32 resourceId) {
+    return AudioApiNative_PinResource(resourceId);
+}
+
+RECOMP_EXPORT bool AudioApi_UnpinResource(u32 resourceId) {
+    return AudioApiNative_UnpinResource(resourceId);
+}
+
+RECOMP_EXPORT bool AudioApi_EvictResource(u32 resourceId) {
+    return AudioApiNative_EvictResource(resourceId);
+}
+
+/* Sample rate that audio files registered afterwards are resampled to on decode, unless their info
+ * options set targetSampleRate. 0 (the default) keeps each file's own rate. */
+RECOMP_EXPORT void AudioApi_SetResampleRate(u32 rate) {
+    AudioApiNative_SetResampleRate(rate);
+}
+
+/* Most audio files that keep their file and decoder open between decodes, 64 by default. The least
+ * recently used idle ones are closed beyond it and reopened on their next decode. */
+RECOMP_EXPORT void AudioApi_SetOpenFileLimit(u32 limit) {
+    AudioApiNative_SetOpenFileLimit(limit);
+}
+
+/* Must be called before AudioApi_Ready to affect this launch's warm start. */
+RECOMP_EXPORT void AudioApi_SetWarmStartBudget(u32 budget) {
+    AudioApiNative_SetWarmStartBudget(budget);
+}
+
+RECOMP_EXPORT void AudioApi_SetTracing(bool enabled) {
+    AudioApiNative_SetTracing(enabled);
+}
+
+RECOMP_EXPORT bool AudioApi_DumpTrace() {
+    return AudioApiNative_DumpTrace();
+}
+
+/* Returns false for an unknown type. Reset periodically to watch recent latencies only. */
+RECOMP_EXPORT bool AudioApi_GetStreamingStats(AudioApiStreamingStats* stats, AudioApiStatsType type) {
+    return AudioApiNative_GetStreamingStats(stats, type);
+}
+
+RECOMP_EXPORT void AudioApi_ResetStreamingStats() {
+    AudioApiNative_ResetStreamingStats();
+}
+
+/* Fills up to maxEntries entries and returns the number of resources, call with 0 to size the array. */
+RECOMP_EXPORT u32 AudioApi_GetResourceMemory(AudioApiResourceMemory* entries, u32 maxEntries, AudioApiMemorySort sort) {
+    return AudioApiNative_GetResourceMemory(entries, maxEntries, sort);
+}
+
+RECOMP_EXPORT void AudioApi_GetMemoryTotal(AudioApiMemoryTotal* total) {
+    AudioApiNative_GetMemoryTotal(total);
+}
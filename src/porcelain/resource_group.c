@@ -0,0 +1,88 @@
+/*
+ * resource_group.c — Porcelain API for managing filesystem resources as a unit.
+ *
+ * A group is a set of resourceIds, e.g. every stem of an area's music. Groups let a mod warm
+ * the next area's resources during a scene transition and drop the previous ones afterwards,
+ * instead of relying on each resource's cache strategy and TTL.
+ *
+ *   CreateResourceGroup   — returns a new, empty groupId
+ *   AddToResourceGroup    — adds a resource, removed resources are skipped by the calls below
+ *   PrefetchResourceGroup — fully loads every resource on the native worker thread. With notify set,
+ *                           AudioApi_ResourceGroupReady(groupId) fires from the audio thread once done
+ *   IsResourceGroupReady  — polls whether the last prefetch has finished
+ *   Pin/UnpinResourceGroup, ReleaseResourceGroup (unpin + evict) — as the per-resource calls
+ */
+#include <global.h>
+#include <recomp/modding.h>
+#include <utils/dynamicdataarray.h>
+
+#include <audio_api/types.h>
+
+#define PENDING_GROUPS_DEFAULT_CAPACITY 8
+
+RECOMP_IMPORT(".", u32 AudioApiNative_CreateResourceGroup());
+RECOMP_IMPORT(".", bool AudioApiNative_AddToResourceGroup(u32 groupId, u32 resourceId));
+RECOMP_IMPORT(".", bool AudioApiNative_PrefetchResourceGroup(u32 groupId));
+RECOMP_IMPORT(".", bool AudioApiNative_IsResourceGroupReady(u32 groupId));
+RECOMP_IMPORT(".", bool AudioApiNative_PinResourceGroup(u32 groupId));
+RECOMP_IMPORT(".", bool AudioApiNative_UnpinResourceGroup(u32 groupId));
+RECOMP_IMPORT(".", bool AudioApiNative_ReleaseResourceGroup(u32 groupId));
+
+RECOMP_DECLARE_EVENT(AudioApi_ResourceGroupReady(u32 groupId));
+
+// Groups waiting for their prefetch to finish before AudioApi_ResourceGroupReady fires
+DynamicDataArray pendingResourceGroups;
+
+RECOMP_CALLBACK(".", AudioApi_InitInternal) void AudioApi_ResourceGroupInit() {
+    DynDataArr_init(&pendingResourceGroups, sizeof(u32), PENDING_GROUPS_DEFAULT_CAPACITY);
+}
+
+RECOMP_CALLBACK(".", AudioApi_UpdateInternal) void AudioApi_ResourceGroupUpdate() {
+    u32 groupId;
+    size_t i = 0;
+
+    while (i < pendingResourceGroups.count) {
+        groupId = *(u32*)DynDataArr_get(&pendingResourceGroups, i);
+        if (!AudioApiNative_IsResourceGroupReady(groupId)) {
+            i++;
+            continue;
+        }
+        DynDataArr_removeByIndex(&pendingResourceGroups, i);
+        AudioApi_ResourceGroupReady(groupId);
+    }
+}
+
+RECOMP_EXPORT u32 AudioApi_CreateResourceGroup() {
+    return AudioApiNative_CreateResourceGroup();
+}
+
+RECOMP_EXPORT bool AudioApi_AddToResourceGroup(u32 groupId, u32 resourceId) {
+    return AudioApiNative_AddToResourceGroup(groupId, resourceId);
+}
+
+RECOMP_EXPORT bool AudioApi_PrefetchResourceGroup(u32 groupId, bool notify) {
+    if (!AudioApiNative_PrefetchResourceGroup(groupId)) {
+        return false;
+    }
+    if (notify) {
+        DynDataArr_removeByValue(&pendingResourceGroups, &groupId);
+        DynDataArr_push(&pendingResourceGroups, &groupId);
+    }
+    return true;
+}
+
+RECOMP_EXPORT bool AudioApi_IsResourceGroupReady(u32 groupId) {
+    return AudioApiNative_IsResourceGroupReady(groupId);
+}
+
+RECOMP_EXPORT bool AudioApi_PinResourceGroup(u32 groupId) {
+    return AudioApiNative_PinResourceGroup(groupId);
+}
+
+RECOMP_EXPORT bool AudioApi_UnpinResourceGroup(u32 groupId) {
+    return AudioApiNative_UnpinResourceGroup(groupId);
+}
+
+RECOMP_EXPORT bool AudioApi_ReleaseResourceGroup(u32 groupId) {
+    return AudioApiNative_ReleaseResourceGroup(groupId);
+}
@@ -0,0 +1,405 @@
+// Decoder benchmark: first-frame latency (open + probe + first chunk), sequential decode throughput
+// and random seek latency of every decoder, read from native files and from a store-only zip.
+//
+// WAV, Vorbis and Opus assets are generated. FLAC and MP3 have no encoder among our dependencies,
+// pass a directory of files with --assets to include them (or any other real-world material).
+//
+// Usage: decoder_bench [--assets DIR] [--work DIR] [--seconds N] [--seeks N] [--runs N]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <miniz.h>
+#include <ogg/ogg.h>
+#include <opus.h>
+#include <vorbis/vorbisenc.h>
+
+#include <extlib/decoder/abstract.hpp>
+#include <extlib/vfs/native_file.hpp>
+#include <extlib/vfs/zip_archive.hpp>
+#include <extlib/vfs/zip_file.hpp>
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t CHUNK_FRAMES = 1024; // Same as Resource::Audiofile
+constexpr uint32_t CHANNELS = 2;
+constexpr double TAU = 2 * std::numbers::pi;
+
+struct Options {
+    fs::path assets;
+    fs::path work = fs::temp_directory_path() / "audio_api_bench";
+    uint32_t seconds = 60;
+    uint32_t seeks = 200;
+    uint32_t runs = 20;
+};
+
+// ======== ASSET GENERATION ========
+
+// A few detuned partials and a little noise, so encoders can't cheat on pure silence or tones
+static std::vector<float> synthesize(uint32_t sampleRate, uint32_t seconds) {
+    std::vector<float> pcm(static_cast<size_t>(sampleRate) * seconds * CHANNELS);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+
+    for (size_t i = 0; i < pcm.size() / CHANNELS; i++) {
+        double t = static_cast<double>(i) / sampleRate;
+        for (uint32_t ch = 0; ch < CHANNELS; ch++) {
+            double f = 220.0 * (1 + ch * 0.003);
+            double v = 0.4 * std::sin(TAU * f * t) + 0.2 * std::sin(TAU * f * 2.01 * t)
+                     + 0.1 * std::sin(TAU * f * 3.98 * t) * std::sin(TAU * 0.5 * t);
+            pcm[i * CHANNELS + ch] = static_cast<float>(v) + noise(rng);
+        }
+    }
+
+    return pcm;
+}
+
+static void put16(std::ofstream& out, uint16_t v) {
+    out.put(v & 0xFF).put(v >> 8);
+}
+
+static void put32(std::ofstream& out, uint32_t v) {
+    put16(out, v & 0xFFFF);
+    put16(out, v >> 16);
+}
+
+static void writeWav(const fs::path& path, uint32_t sampleRate, const std::vector<float>& pcm) {
+    std::ofstream out(path, std::ios::binary);
+    uint32_t dataSize = pcm.size() * sizeof(int16_t);
+
+    out.write("RIFF", 4);
+    put32(out, 36 + dataSize);
+    out.write("WAVEfmt ", 8);
+    put32(out, 16);
+    put16(out, 1);
+    put16(out, CHANNELS);
+    put32(out, sampleRate);
+    put32(out, sampleRate * CHANNELS * sizeof(int16_t));
+    put16(out, CHANNELS * sizeof(int16_t));
+    put16(out, 16);
+    out.write("data", 4);
+    put32(out, dataSize);
+
+    for (float v : pcm) {
+        put16(out, static_cast<uint16_t>(static_cast<int16_t>(std::clamp(v, -1.0f, 1.0f) * 32767)));
+    }
+}
+
+static void writePages(std::ofstream& out, ogg_stream_state* os, bool flush) {
+    ogg_page og;
+    while (flush ? ogg_stream_flush(os, &og) : ogg_stream_pageout(os, &og)) {
+        out.write(reinterpret_cast<char*>(og.header), og.header_len);
+        out.write(reinterpret_cast<char*>(og.body), og.body_len);
+    }
+}
+
+static void writeVorbis(const fs::path& path, uint32_t sampleRate, const std::vector<float>& pcm) {
+    std::ofstream out(path, std::ios::binary);
+    vorbis_info vi;
+    vorbis_comment vc;
+    vorbis_dsp_state vd;
+    vorbis_block vb;
+    ogg_stream_state os;
+    ogg_packet header, headerComment, headerCode, op;
+
+    vorbis_info_init(&vi);
+    if (vorbis_encode_init_vbr(&vi, CHANNELS, sampleRate, 0.4f) != 0) {
+        throw std::runtime_error("vorbis_encode_init_vbr failed");
+    }
+    vorbis_comment_init(&vc);
+    vorbis_analysis_init(&vd, &vi);
+    vorbis_block_init(&vd, &vb);
+    ogg_stream_init(&os, 1);
+
+    vorbis_analysis_headerout(&vd, &vc, &header, &headerComment, &headerCode);
+    ogg_stream_packetin(&os, &header);
+    ogg_stream_packetin(&os, &headerComment);
+    ogg_stream_packetin(&os, &headerCode);
+    writePages(out, &os, true);
+
+    size_t frames = pcm.size() / CHANNELS;
+    for (size_t pos = 0; pos <= frames; pos += CHUNK_FRAMES) {
+        size_t count = std::min(CHUNK_FRAMES, frames - pos);
+        if (count > 0) {
+            float** buffer = vorbis_analysis_buffer(&vd, count);
+            for (size_t i = 0; i < count; i++) {
+                for (uint32_t ch = 0; ch < CHANNELS; ch++) {
+                    buffer[ch][i] = pcm[(pos + i) * CHANNELS + ch];
+                }
+            }
+        }
+        vorbis_analysis_wrote(&vd, count);
+
+        while (vorbis_analysis_blockout(&vd, &vb) == 1) {
+            vorbis_analysis(&vb, nullptr);
+            vorbis_bitrate_addblock(&vb);
+            while (vorbis_bitrate_flushpacket(&vd, &op)) {
+                ogg_stream_packetin(&os, &op);
+                writePages(out, &os, false);
+            }
+        }
+    }
+    writePages(out, &os, true);
+
+    ogg_stream_clear(&os);
+    vorbis_block_clear(&vb);
+    vorbis_dsp_clear(&vd);
+    vorbis_comment_clear(&vc);
+    vorbis_info_clear(&vi);
+}
+
+// Ogg Opus as described in RFC 7845, pcm must be 48 kHz
+static void writeOpus(const fs::path& path, const std::vector<float>& pcm) {
+    constexpr int FRAME = 960;
+    std::ofstream out(path, std::ios::binary);
+    int error;
+
+    OpusEncoder* encoder = opus_encoder_create(48000, CHANNELS, OPUS_APPLICATION_AUDIO, &error);
+    if (error != OPUS_OK) {
+        throw std::runtime_error("opus_encoder_create failed");
+    }
+    opus_int32 preSkip;
+    opus_encoder_ctl(encoder, OPUS_GET_LOOKAHEAD(&preSkip));
+
+    ogg_stream_state os;
+    ogg_stream_init(&os, 2);
+
+    uint8_t head[19] = { 'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1, CHANNELS,
+                         static_cast<uint8_t>(preSkip & 0xFF), static_cast<uint8_t>(preSkip >> 8),
+                         0x80, 0xBB, 0x00, 0x00, 0, 0, 0 };
+    uint8_t tags[16] = { 'O', 'p', 'u', 's', 'T', 'a', 'g', 's', 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    ogg_packet op{};
+    op.packet = head;
+    op.bytes = sizeof(head);
+    op.b_o_s = 1;
+    ogg_stream_packetin(&os, &op);
+    writePages(out, &os, true);
+
+    op = {};
+    op.packet = tags;
+    op.bytes = sizeof(tags);
+    op.packetno = 1;
+    ogg_stream_packetin(&os, &op);
+    writePages(out, &os, true);
+
+    std::vector<uint8_t> packet(4000);
+    std::vector<float> frame(FRAME * CHANNELS);
+    size_t frames = pcm.size() / CHANNELS;
+
+    for (size_t pos = 0, packetNo = 2; pos < frames; pos += FRAME, packetNo++) {
+        size_t count = std::min<size_t>(FRAME, frames - pos);
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        std::copy_n(pcm.begin() + pos * CHANNELS, count * CHANNELS, frame.begin());
+
+        int bytes = opus_encode_float(encoder, frame.data(), FRAME, packet.data(), packet.size());
+        if (bytes < 0) {
+            throw std::runtime_error("opus_encode_float failed");
+        }
+
+        op = {};
+        op.packet = packet.data();
+        op.bytes = bytes;
+        op.granulepos = pos + count + preSkip;
+        op.packetno = packetNo;
+        op.e_o_s = pos + FRAME >= frames;
+        ogg_stream_packetin(&os, &op);
+        writePages(out, &os, false);
+    }
+    writePages(out, &os, true);
+
+    ogg_stream_clear(&os);
+    opus_encoder_destroy(encoder);
+}
+
+static void writeZip(const fs::path& path, const std::vector<fs::path>& files) {
+    mz_zip_archive zip{};
+
+    fs::remove(path);
+    if (!mz_zip_writer_init_file(&zip, path.string().c_str(), 0)) {
+        throw std::runtime_error("Could not create " + path.string());
+    }
+
+    // The VFS only reads store-only archives
+    for (const auto& file : files) {
+        if (!mz_zip_writer_add_file(&zip, file.filename().string().c_str(), file.string().c_str(),
+                                    nullptr, 0, MZ_NO_COMPRESSION)) {
+            throw std::runtime_error("Could not add " + file.string() + " to zip");
+        }
+    }
+
+    mz_zip_writer_finalize_archive(&zip);
+    mz_zip_writer_end(&zip);
+}
+
+// ======== MEASUREMENT ========
+
+struct Stats {
+    std::vector<double> samples;
+
+    void add(double v) {
+        samples.push_back(v);
+    }
+
+    double percentile(double p) {
+        if (samples.empty()) {
+            return 0;
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+    }
+};
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void benchmark(const std::string& label, std::function<std::shared_ptr<Vfs::File>()> openFile,
+                      const Options& options) {
+    Stats firstFrame, seek;
+    std::vector<int16_t> buffer;
+
+    for (uint32_t run = 0; run < options.runs; run++) {
+        auto start = Clock::now();
+
+        auto decoder = Decoder::factory(openFile());
+        decoder->open();
+        decoder->probe();
+        buffer.resize(CHUNK_FRAMES * decoder->metadata->trackCount);
+        decoder->decode(&buffer, CHUNK_FRAMES, 0);
+
+        firstFrame.add(msSince(start));
+        decoder->close();
+    }
+
+    auto decoder = Decoder::factory(openFile());
+    decoder->open();
+    decoder->probe();
+
+    auto metadata = decoder->metadata;
+    size_t sampleCount = metadata->sampleCount;
+    buffer.resize(CHUNK_FRAMES * metadata->trackCount);
+
+    auto start = Clock::now();
+    for (size_t offset = 0; offset + 1 < sampleCount; offset += CHUNK_FRAMES) {
+        decoder->decode(&buffer, std::min(CHUNK_FRAMES, sampleCount - offset - 1), offset);
+    }
+    double sequentialMs = msSince(start);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> offsets(0, sampleCount > CHUNK_FRAMES * 2 ? sampleCount - CHUNK_FRAMES * 2 : 0);
+
+    for (uint32_t i = 0; i < options.seeks; i++) {
+        size_t offset = offsets(rng) / CHUNK_FRAMES * CHUNK_FRAMES;
+        start = Clock::now();
+        decoder->decode(&buffer, CHUNK_FRAMES, offset);
+        seek.add(msSince(start));
+    }
+    decoder->close();
+
+    double framesPerSecond = sampleCount / (sequentialMs / 1000);
+
+    std::printf("%-28s %11.0f %7.1fx | %7.3f %7.3f %7.3f | %7.3f %7.3f %7.3f %7.3f\n",
+                label.c_str(), framesPerSecond, framesPerSecond / metadata->sampleRate,
+                firstFrame.percentile(0.5), firstFrame.percentile(0.95), firstFrame.percentile(0.99),
+                seek.percentile(0.5), seek.percentile(0.95), seek.percentile(0.99), seek.percentile(1.0));
+}
+
+static bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (arg == "--assets") {
+            options.assets = argv[++i];
+        } else if (arg == "--work") {
+            options.work = argv[++i];
+        } else if (arg == "--seconds") {
+            options.seconds = std::stoul(argv[++i]);
+        } else if (arg == "--seeks") {
+            options.seeks = std::stoul(argv[++i]);
+        } else if (arg == "--runs") {
+            options.runs = std::stoul(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if (!parseArgs(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--assets DIR] [--work DIR] [--seconds N] [--seeks N] [--runs N]\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        fs::create_directories(options.work);
+
+        std::vector<fs::path> files = {
+            options.work / "generated.wav",
+            options.work / "generated.ogg",
+            options.work / "generated.opus",
+        };
+
+        std::printf("Generating %u s stereo assets in %s\n", options.seconds, options.work.string().c_str());
+        auto pcm44 = synthesize(44100, options.seconds);
+        writeWav(files[0], 44100, pcm44);
+        writeVorbis(files[1], 44100, pcm44);
+        writeOpus(files[2], synthesize(48000, options.seconds));
+
+        if (!options.assets.empty()) {
+            for (const auto& entry : fs::directory_iterator(options.assets)) {
+                if (entry.is_regular_file()) {
+                    auto target = options.work / entry.path().filename();
+                    fs::copy_file(entry.path(), target, fs::copy_options::overwrite_existing);
+                    files.push_back(target);
+                }
+            }
+        }
+
+        auto zipPath = options.work / "bench.zip";
+        writeZip(zipPath, files);
+
+        std::printf("\n%-28s %11s %8s | %-23s | %s\n", "", "frames/s", "realtime",
+                    "first frame ms p50/95/99", "seek ms p50/95/99/max");
+
+        for (const auto& path : files) {
+            auto name = path.filename().string();
+
+            try {
+                benchmark(name + " (native)", [&]() {
+                    return std::make_shared<Vfs::NativeFile>(path);
+                }, options);
+
+                benchmark(name + " (zip)", [&]() {
+                    return std::make_shared<Vfs::ZipFile>(Vfs::ZipArchive::factory(zipPath), path.filename());
+                }, options);
+            } catch (const std::runtime_error& e) {
+                std::printf("%-28s skipped: %s\n", name.c_str(), e.what());
+            }
+        }
+
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}
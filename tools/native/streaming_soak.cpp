@@ -0,0 +1,305 @@
+// Streaming soak test: N audio files streamed through Resource::Audiofile::dma at real-time pace,
+// the way the audio thread pulls them, while the extlib worker thread preloads and collects in the
+// background. Tracks change pitch, loop and seek at random.
+//
+// Reports deadline misses (a DMA taking longer than its budget), synchronous decodes on the
+// streaming thread, decodes joined instead of repeated, peak memory and the cached chunk count at
+// the end. Exits with 1 if the deadline miss rate is above --max-miss-rate, so it can run headless
+// in CI.
+//
+// Usage: streaming_soak [--tracks N] [--seconds N] [--period-ms N] [--budget-ms N]
+//                       [--max-miss-rate F] [--work DIR] [--seed N]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+#include <extlib/main.hpp>
+#include <extlib/resource/audiofile.hpp>
+#include <extlib/thread.hpp>
+#include <extlib/vfs/native_file.hpp>
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t SAMPLE_RATE = 32000;
+constexpr uint32_t TRACK_COUNT = 2;
+constexpr size_t RDRAM_SIZE = 8 * 1024 * 1024;
+constexpr size_t TRACK_DMA_STRIDE = 0x4000;
+constexpr double TAU = 2 * std::numbers::pi;
+
+struct Options {
+    uint32_t tracks = 8;
+    uint32_t seconds = 120;
+    double periodMs = 5.0;
+    double budgetMs = 2.0;
+    double maxMissRate = 0.001;
+    uint32_t seed = 1;
+    fs::path work = fs::temp_directory_path() / "audio_api_soak";
+};
+
+struct Track {
+    size_t resourceId;
+    std::shared_ptr<Resource::Audiofile> resource;
+    double pos = 0;
+    double pitch = 1.0;
+    uint32_t trackNo = 0;
+};
+
+static void put16(std::ofstream& out, uint16_t v) {
+    out.put(v & 0xFF).put(v >> 8);
+}
+
+static void put32(std::ofstream& out, uint32_t v) {
+    put16(out, v & 0xFFFF);
+    put16(out, v >> 16);
+}
+
+// Stereo 16-bit WAV, each file a different tone so no two decode to the same data. A smpl chunk
+// loops the last three quarters forever, so probing finds the loop like it would in a game file.
+static void writeWav(const fs::path& path, uint32_t seconds, double frequency) {
+    std::ofstream out(path, std::ios::binary);
+    uint32_t frames = SAMPLE_RATE * seconds;
+    uint32_t dataSize = frames * TRACK_COUNT * sizeof(int16_t);
+    uint32_t smplSize = 36 + 24;
+
+    out.write("RIFF", 4);
+    put32(out, 36 + dataSize + 8 + smplSize);
+    out.write("WAVEfmt ", 8);
+    put32(out, 16);
+    put16(out, 1);
+    put16(out, TRACK_COUNT);
+    put32(out, SAMPLE_RATE);
+    put32(out, SAMPLE_RATE * TRACK_COUNT * sizeof(int16_t));
+    put16(out, TRACK_COUNT * sizeof(int16_t));
+    put16(out, 16);
+    out.write("data", 4);
+    put32(out, dataSize);
+
+    for (uint32_t i = 0; i < frames; i++) {
+        double t = static_cast<double>(i) / SAMPLE_RATE;
+        for (uint32_t ch = 0; ch < TRACK_COUNT; ch++) {
+            put16(out, static_cast<uint16_t>(static_cast<int16_t>(12000 * std::sin(TAU * frequency * (1 + ch * 0.01) * t))));
+        }
+    }
+
+    out.write("smpl", 4);
+    put32(out, smplSize);
+    for (int i = 0; i < 7; i++) {
+        put32(out, 0);                      // Manufacturer, product, period, MIDI note, SMPTE
+    }
+    put32(out, 1);                          // Loop count
+    put32(out, 0);                          // Sampler data
+    put32(out, 0);                          // Cue point id
+    put32(out, 0);                          // Forward loop
+    put32(out, frames / 4);
+    put32(out, frames - 1);
+    put32(out, 0);                          // Fraction
+    put32(out, 0);                          // Play count, 0 = forever
+}
+
+static size_t peakMemoryBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    #if defined(__APPLE__)
+        return usage.ru_maxrss;
+    #else
+        return usage.ru_maxrss * 1024;
+    #endif
+#endif
+}
+
+static bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (arg == "--tracks") {
+            options.tracks = std::stoul(argv[++i]);
+        } else if (arg == "--seconds") {
+            options.seconds = std::stoul(argv[++i]);
+        } else if (arg == "--period-ms") {
+            options.periodMs = std::stod(argv[++i]);
+        } else if (arg == "--budget-ms") {
+            options.budgetMs = std::stod(argv[++i]);
+        } else if (arg == "--max-miss-rate") {
+            options.maxMissRate = std::stod(argv[++i]);
+        } else if (arg == "--seed") {
+            options.seed = std::stoul(argv[++i]);
+        } else if (arg == "--work") {
+            options.work = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+
+    if (!parseArgs(argc, argv, options) || options.tracks == 0 || options.periodMs <= 0) {
+        std::fprintf(stderr, "Usage: %s [--tracks N] [--seconds N] [--period-ms N] [--budget-ms N] "
+                             "[--max-miss-rate F] [--work DIR] [--seed N]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> memory(RDRAM_SIZE);
+    uint8_t* rdram = memory.data();
+    std::mt19937 rng(options.seed);
+    std::vector<Track> tracks;
+
+    try {
+        fs::create_directories(options.work);
+
+        // Files are shorter than the run so every track loops several times
+        for (uint32_t i = 0; i < options.tracks; i++) {
+            auto path = options.work / ("track" + std::to_string(i) + ".wav");
+            writeWav(path, 20 + i % 5 * 7, 110.0 * (i + 1));
+
+            auto file = std::make_shared<Vfs::NativeFile>(path);
+            auto resource = std::make_shared<Resource::Audiofile>(file, Decoder::Type::Wav);
+            resource->open();
+            resource->probe();
+            resource->close();
+
+            {
+                std::unique_lock<std::shared_mutex> lock(gResourceDataMutex);
+                gResourceData[i] = resource;
+            }
+            queuePreload(i);
+
+            tracks.push_back({ i, resource, 0, 1.0, i % TRACK_COUNT });
+        }
+
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Setup error: %s\n", e.what());
+        return 1;
+    }
+
+    std::thread(workerThreadLoop).detach();
+
+    std::uniform_real_distribution<double> chance(0, 1);
+    std::uniform_real_distribution<double> pitches(0.5, 2.0);
+
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(options.periodMs));
+    size_t ticks = static_cast<size_t>(options.seconds * 1000 / options.periodMs);
+    size_t dmas = 0, misses = 0, lateTicks = 0, errors = 0;
+    double worstMs = 0;
+
+    std::printf("Streaming %u tracks for %u s, %.1f ms period, %.1f ms budget per DMA\n",
+                options.tracks, options.seconds, options.periodMs, options.budgetMs);
+
+    auto start = Clock::now();
+    auto next = start;
+
+    for (size_t tick = 0; tick < ticks; tick++) {
+        for (size_t i = 0; i < tracks.size(); i++) {
+            auto& track = tracks[i];
+            auto metadata = track.resource->metadata;
+
+            // Roughly every few seconds per track: new pitch, or a seek anywhere in the file
+            if (chance(rng) < options.periodMs / 3000) {
+                track.pitch = pitches(rng);
+            }
+            if (chance(rng) < options.periodMs / 20000) {
+                track.pos = std::uniform_int_distribution<size_t>(0, metadata->sampleCount - 1)(rng);
+            }
+
+            size_t count = std::ceil(metadata->sampleRate * track.pitch * options.periodMs / 1000);
+            size_t offset = static_cast<size_t>(track.pos);
+            if (offset + count >= metadata->loopEnd) {
+                offset = metadata->loopStart;
+                track.pos = offset;
+            }
+
+            int32_t ptr = static_cast<int32_t>(0x80000000 + i * TRACK_DMA_STRIDE);
+            count = std::min(count, TRACK_DMA_STRIDE / sizeof(int16_t));
+
+            auto dmaStart = Clock::now();
+            try {
+                // arg2 tells streams apart, the way the game keys the playheads of a file
+                track.resource->dma(rdram, ptr, offset, count, track.trackNo, static_cast<uint32_t>(i + 1));
+            } catch (const std::exception& e) {
+                errors++;
+            }
+            double dmaMs = std::chrono::duration<double, std::milli>(Clock::now() - dmaStart).count();
+
+            queuePreload(track.resourceId);
+            dmas++;
+            worstMs = std::max(worstMs, dmaMs);
+            if (dmaMs > options.budgetMs) {
+                misses++;
+            }
+
+            track.pos += count;
+        }
+
+        workerThreadNotify();
+
+        next += period;
+        if (Clock::now() > next) {
+            lateTicks++;
+        } else {
+            std::this_thread::sleep_until(next);
+        }
+
+        if (tick > 0 && tick % static_cast<size_t>(10000 / options.periodMs) == 0) {
+            std::printf("%5.0f s: %zu DMAs, %zu deadline misses, worst %.3f ms\n",
+                        std::chrono::duration<double>(Clock::now() - start).count(), dmas, misses, worstMs);
+            std::fflush(stdout);
+        }
+    }
+
+    size_t syncDecodes = 0, joinedDecodes = 0, cachedChunks = 0;
+    for (auto& track : tracks) {
+        syncDecodes += track.resource->syncDecodes.load();
+        joinedDecodes += track.resource->joinedDecodes.load();
+        cachedChunks += track.resource->getCachedChunks();
+    }
+
+    double missRate = dmas > 0 ? static_cast<double>(misses) / dmas : 0;
+
+    std::printf("\nDMAs:              %zu\n", dmas);
+    std::printf("Deadline misses:   %zu (%.4f%%, worst %.3f ms)\n", misses, missRate * 100, worstMs);
+    std::printf("Late ticks:        %zu of %zu\n", lateTicks, ticks);
+    std::printf("Sync decodes:      %zu\n", syncDecodes);
+    std::printf("Joined decodes:    %zu\n", joinedDecodes);
+    std::printf("DMA errors:        %zu\n", errors);
+    std::printf("Cached chunks:     %zu\n", cachedChunks);
+    std::printf("Peak memory:       %.1f MiB\n", peakMemoryBytes() / (1024.0 * 1024.0));
+
+    if (errors > 0 || missRate > options.maxMissRate) {
+        std::printf("FAIL: deadline miss rate above %.4f%% or DMA errors\n", options.maxMissRate * 100);
+        return 1;
+    }
+
+    std::printf("PASS\n");
+    return 0;
+}
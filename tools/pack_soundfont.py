@@ -0,0 +1,74 @@
+import argparse, struct, sys
+from pathlib import Path
+
+# Must match SoundFontType and SOUNDFONT_PACKED_HEADER_SIZE in include/audio_api/soundfont.h
+SOUNDFONT_PACKED = 2
+SOUNDFONT_PACKED_HEADER_SIZE = 0x20
+SOUNDFONT_INSTRUMENT_OFFSET = 2
+SOUNDFONT_MAX_INSTRUMENTS = 126
+
+# CustomSoundFont as laid out by the mod (big-endian, 32-bit pointers), padded to the header size
+HEADER_FORMAT = ">BBHHBBHBBH2xIII4x"
+
+def read_word(image: bytes, index: int) -> int:
+    return struct.unpack_from(">I", image, index * 4)[0]
+
+def check_offset(image: bytes, offset: int, what: str) -> bool:
+    if offset >= len(image) or offset % 4 != 0:
+        print(f"Invalid {what} offset 0x{offset:X} (image is 0x{len(image):X} bytes)")
+        return False
+    return True
+
+def pack(image: bytes, args: argparse.Namespace) -> bytes | None:
+    if len(image) < (SOUNDFONT_INSTRUMENT_OFFSET + args.instruments) * 4:
+        print("Image is too small for the given instrument count")
+        return None
+
+    drums_offset = read_word(image, 0)
+    sfx_offset = read_word(image, 1)
+    instruments_offset = SOUNDFONT_INSTRUMENT_OFFSET * 4
+
+    if args.drums > 0 and not check_offset(image, drums_offset, "drum list"):
+        return None
+    if args.sfx > 0 and not check_offset(image, sfx_offset, "sfx list"):
+        return None
+    for i in range(args.instruments):
+        offset = read_word(image, SOUNDFONT_INSTRUMENT_OFFSET + i)
+        if offset != 0 and not check_offset(image, offset, f"instrument {i}"):
+            return None
+
+    header = struct.pack(HEADER_FORMAT, SOUNDFONT_PACKED, 0, args.bank1, args.bank2,
+                         args.instruments, args.drums, args.sfx, 0, 0, 0,
+                         instruments_offset, drums_offset, sfx_offset)
+    assert len(header) == SOUNDFONT_PACKED_HEADER_SIZE
+
+    blob = header + image
+    return blob + bytes(-len(blob) % 16)
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Pack a vanilla-layout soundfont binary into a SOUNDFONT_PACKED blob "
+                                                 "that can be loaded with AudioApi_AddSoundFontFromFs.")
+    parser.add_argument("input", type=Path, help="vanilla-layout soundfont binary (big-endian, offsets relative to its start)")
+    parser.add_argument("-o", "--output", type=Path, required=True)
+    parser.add_argument("--bank1", type=int, default=1, help="primary sample bank id")
+    parser.add_argument("--bank2", type=int, default=255, help="secondary sample bank id (255 = none)")
+    parser.add_argument("--instruments", type=int, default=0)
+    parser.add_argument("--drums", type=int, default=0)
+    parser.add_argument("--sfx", type=int, default=0)
+    args = parser.parse_args()
+
+    if not 0 <= args.instruments <= SOUNDFONT_MAX_INSTRUMENTS or not 0 <= args.drums <= 0xFF \
+            or not 0 <= args.sfx <= 0xFFFF:
+        print("Instrument, drum or sfx count out of range")
+        return 1
+
+    blob = pack(args.input.read_bytes(), args)
+    if blob is None:
+        return 1
+
+    args.output.write_bytes(blob)
+    print(f"Packed {args.input} -> {args.output} ({len(blob)} bytes)")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())